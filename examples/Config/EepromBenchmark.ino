@@ -0,0 +1,90 @@
+#include <Arduino.h>
+#include <ArduinoCommon/Config/EepromStorage.h>
+
+using ArduinoCommon::Config::EepromStorage;
+
+// Compares EepromStorage's block transfers against the original
+// byte-by-byte EEPROM.read()/EEPROM.update() loops and prints the
+// throughput of each in bytes per microsecond.
+//
+// What is compared depends on the core: only cores with a RAM-buffered
+// EEPROM (ESP32, ESP8266) or AVR have a block path. Elsewhere, e.g. on
+// the Uno R4, EepromStorage also loops byte by byte and the two columns
+// should be about equal.
+//
+// test/test_Benchmarks runs the same comparison on the host:
+// pio test -e native -f test_Benchmarks
+
+const size_t BLOCK = 64;
+const uint16_t ROUNDS = 200;
+
+EepromStorage storage(BLOCK);
+uint8_t buffer[BLOCK];
+
+void bytewiseRead() {
+  for (size_t i = 0; i < BLOCK; ++i) buffer[i] = EEPROM.read(i);
+}
+
+void bytewiseWrite() {
+  for (size_t i = 0; i < BLOCK; ++i) EEPROM.update(i, buffer[i]);
+}
+
+bool bytewiseIsUsed() {
+  for (size_t i = 0; i < BLOCK; ++i) {
+    if (EEPROM.read(i) != 0xFF) return true;
+  }
+  return false;
+}
+
+void report(const __FlashStringHelper* name, uint32_t beforeUs,
+            uint32_t afterUs) {
+  const float bytes = static_cast<float>(BLOCK) * ROUNDS;
+  Serial.print(name);
+  Serial.print(F(": before "));
+  Serial.print(bytes / (beforeUs ? beforeUs : 1), 3);
+  Serial.print(F(" B/us, after "));
+  Serial.print(bytes / (afterUs ? afterUs : 1), 3);
+  Serial.println(F(" B/us"));
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(200);
+
+#if ARDUINOCOMMON_EEPROM_HAS_DATA_PTR
+  Serial.println(F("EepromStorage path: RAM buffer"));
+#elif ARDUINOCOMMON_EEPROM_HAS_AVR_BLOCK
+  Serial.println(F("EepromStorage path: AVR block"));
+#else
+  Serial.println(F("EepromStorage path: byte loop"));
+#endif
+
+  // Unchanged data: measures the compare cost, not EEPROM wear.
+  storage.clear(0, BLOCK);
+  memset(buffer, 0xFF, sizeof(buffer));
+  volatile bool sink = false;
+
+  uint32_t t0 = micros();
+  for (uint16_t r = 0; r < ROUNDS; ++r) bytewiseRead();
+  uint32_t before = micros() - t0;
+  t0 = micros();
+  for (uint16_t r = 0; r < ROUNDS; ++r) storage.read(0, buffer, BLOCK);
+  report(F("read"), before, micros() - t0);
+
+  t0 = micros();
+  for (uint16_t r = 0; r < ROUNDS; ++r) bytewiseWrite();
+  before = micros() - t0;
+  t0 = micros();
+  for (uint16_t r = 0; r < ROUNDS; ++r) storage.write(0, buffer, BLOCK);
+  report(F("write (unchanged)"), before, micros() - t0);
+
+  t0 = micros();
+  for (uint16_t r = 0; r < ROUNDS; ++r) sink = bytewiseIsUsed();
+  before = micros() - t0;
+  t0 = micros();
+  for (uint16_t r = 0; r < ROUNDS; ++r) sink = storage.isUsed(0, BLOCK);
+  report(F("isUsed"), before, micros() - t0);
+  (void)sink;
+}
+
+void loop() {}
@@ -5,7 +5,7 @@ using ArduinoCommon::Display::LCD1602;
 
 LCD1602 lcd(A4, A5);
 
-void formatUptime(char* buf, size_t len);
+void showUptime();
 
 bool lcdReady = false;
 
@@ -27,17 +27,22 @@ void loop() {
     return;
   }
 
-  char timeBuf[17];
-  formatUptime(timeBuf, sizeof(timeBuf));
-  lcd.printLine(1, timeBuf);
+  showUptime();
 
   delay(1000);
 }
 
-void formatUptime(char* buf, size_t len) {
+// Formats h:mm:ss straight into the framebuffer; only the digits that
+// changed are sent to the display. millis() wraps after 1193 hours, so
+// four cells always hold the hours.
+void showUptime() {
   unsigned long seconds = millis() / 1000;
   unsigned long mins = (seconds / 60) % 60;
   unsigned long hrs = (seconds / 3600);
 
-  snprintf(buf, len, "%02lu:%02lu:%02lu", hrs, mins, seconds % 60);
+  lcd.field(1, 0, 4).printUnsigned(hrs);
+  lcd.field(1, 4, 1).print(':');
+  lcd.field(1, 5, 2).zeroPad().printUnsigned(mins);
+  lcd.field(1, 7, 1).print(':');
+  lcd.field(1, 8, 2).zeroPad().printUnsigned(seconds % 60);
 }
@@ -0,0 +1,37 @@
+#include <Arduino.h>
+#include <ArduinoCommon.h>
+
+using ArduinoCommon::Sensors::Ema;
+using ArduinoCommon::Sensors::FilteredSensor;
+using ArduinoCommon::Sensors::Median;
+using ArduinoCommon::Sensors::SoilSensor;
+
+SoilSensor soil(A0);
+
+// Median rejects single-sample spikes, EMA smooths what is left.
+FilteredSensor<SoilSensor, Median<5>, Ema<32>> filtered(soil);
+
+unsigned long lastSample = 0;
+unsigned long lastPrint = 0;
+
+void setup() {
+  Serial.begin(9600);
+  delay(200);
+
+  soil.begin(500, 200);  // Example calibration (dry=500, wet=200)
+}
+
+void loop() {
+  // One ADC conversion every 50 ms keeps the filters fed.
+  if (millis() - lastSample >= 50) {
+    lastSample = millis();
+    filtered.update();
+  }
+
+  if (millis() - lastPrint >= 1000) {
+    lastPrint = millis();
+    soil.logRaw(Serial, "Unfiltered");
+    filtered.logRaw(Serial, "Filtered");
+    filtered.logPercent(Serial, "Moisture");
+  }
+}
@@ -0,0 +1,33 @@
+#include <Arduino.h>
+#include <ArduinoCommon.h>
+
+using ArduinoCommon::Sensors::SensorGroup;
+
+// Up to 8 probes, stored as contiguous arrays and read in one pass.
+SensorGroup<8> probes;
+
+void setup() {
+  Serial.begin(9600);
+  delay(200);
+
+  probes.add(A0, 500, 200);
+  probes.add(A1, 550, 250);
+  probes.add(A2, 520, 230);
+
+  Serial.println(F("Starting sensor group demo..."));
+}
+
+void loop() {
+  probes.update();  // read every channel, then convert all at once
+
+  for (uint8_t i = 0; i < probes.count(); i++) {
+    Serial.print("Sensor ");
+    Serial.print(i);
+    Serial.print(": ");
+    Serial.print(probes.percent(i));
+    Serial.println("%");
+  }
+
+  Serial.println();
+  delay(1500);
+}
@@ -0,0 +1,40 @@
+#include <Arduino.h>
+#include <ArduinoCommon.h>
+
+using ArduinoCommon::Sensors::SoilSensor;
+
+SoilSensor soil(A0);
+
+unsigned long lastBlink = 0;
+bool ledOn = false;
+
+void setup() {
+  Serial.begin(9600);
+  delay(200);
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  soil.begin(500, 200);  // Example calibration (dry=500, wet=200)
+  soil.startSampling(10, 10);  // 10 samples, 10 ms apart
+}
+
+void loop() {
+  // Takes at most one sample per call and never blocks.
+  soil.update();
+
+  if (soil.isReady()) {
+    Serial.print("Averaged raw: ");
+    Serial.print(soil.sampledRaw());
+    Serial.print("    Moisture: ");
+    Serial.print(soil.sampledPercent());
+    Serial.println("%");
+
+    soil.startSampling(10, 10);
+  }
+
+  // Other work keeps running while samples are being collected.
+  if (millis() - lastBlink >= 250) {
+    lastBlink = millis();
+    ledOn = !ledOn;
+    digitalWrite(LED_BUILTIN, ledOn ? HIGH : LOW);
+  }
+}
@@ -1,16 +1,30 @@
 #include <ArduinoCommon.h>
 
+using ArduinoCommon::Sensors::IAnalogSensor;
+using ArduinoCommon::Sensors::SensorEvent;
+using ArduinoCommon::Sensors::WatchEvent;
+using ArduinoCommon::Sensors::WatchSource;
+
 ArduinoCommon::Sensors::SoilSensor sensor(A0);
 
+// Called only when the moisture crosses 30 % (re-arms at 35 %).
+void onMoistureChange(IAnalogSensor&, const SensorEvent& event, void*) {
+  if (event.type == WatchEvent::Below) {
+    // ? pump.dispenseML(100);
+  }
+}
+
 void setup() {
   Serial.begin(9600);
   sensor.begin();
+  sensor.addThresholdWatch(WatchSource::Percent, 30, 5, onMoistureChange);
+  sensor.startSampling(10, 10);
 }
 
 void loop() {
-  int moisture = sensor.readPercent();
-  if (moisture < 30) {
-    // ? pump.dispenseML(100);
+  sensor.update();  // evaluates the watch when a reading completes
+
+  if (sensor.isReady()) {
+    sensor.startSampling(10, 200);  // next reading spread over ~2 s
   }
-  delay(2000);
 }
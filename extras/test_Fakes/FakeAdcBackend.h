@@ -0,0 +1,50 @@
+#pragma once
+#include <Arduino.h>
+#include <ArduinoCommon/Sensors/AdcScanner.h>
+
+/**
+ * Host-side stand-in for a hardware ADC scan. Each poll() simulates one
+ * completed scan of every channel, pushing the values set via setValue().
+ */
+class FakeAdcBackend : public ArduinoCommon::Sensors::IAdcBackend {
+ public:
+  static constexpr uint8_t MaxChannels =
+      ArduinoCommon::Sensors::AdcScanner::MaxChannels;
+
+  bool begin(ArduinoCommon::Sensors::AdcScanner& s, const uint8_t* pins,
+             uint8_t count) override {
+    if (failBegin) return false;
+    scanner = &s;
+    channelCount = count;
+    for (uint8_t i = 0; i < count; ++i) this->pins[i] = pins[i];
+    beginCalled = true;
+    return true;
+  }
+
+  void poll() override {
+    if (!scanner) return;
+    for (uint8_t i = 0; i < channelCount; ++i) scanner->push(i, values[i]);
+    ++scans;
+  }
+
+  void end() override {
+    scanner = nullptr;
+    endCalled = true;
+  }
+
+  void setValue(uint8_t channel, uint16_t value) {
+    if (channel < MaxChannels) values[channel] = value;
+  }
+
+  // Inspectable state
+  bool failBegin = false;
+  bool beginCalled = false;
+  bool endCalled = false;
+  uint32_t scans = 0;
+  uint8_t channelCount = 0;
+  uint8_t pins[MaxChannels] = {};
+  uint16_t values[MaxChannels] = {};
+
+ private:
+  ArduinoCommon::Sensors::AdcScanner* scanner = nullptr;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <Arduino.h>
+#include <string.h>
+#include <ArduinoCommon/Config/IConfigStorage.h>
+
+/**
+ * RAM-backed IConfigStorage for host tests. Counts calls and per-byte
+ * writes so tests can check how writes are spread, and can simulate a
+ * power loss by refusing to write after a byte budget is used up.
+ */
+class FakeConfigStorage : public ArduinoCommon::Config::IConfigStorage {
+ public:
+  static constexpr uint16_t Size = 512;
+
+  FakeConfigStorage() { reset(); }
+
+  void reset() {
+    memset(bytes, 0xFF, sizeof(bytes));
+    memset(cellWrites, 0, sizeof(cellWrites));
+    reads = writes = clears = bytesWritten = 0;
+    writeBudget = -1;
+  }
+
+  bool read(uint16_t key, void* data, size_t len) override {
+    if (key + len > Size) return false;
+    memcpy(data, bytes + key, len);
+    ++reads;
+    return true;
+  }
+
+  bool write(uint16_t key, const void* data, size_t len) override {
+    if (key + len > Size) return false;
+    ++writes;
+    return store(key, static_cast<const uint8_t*>(data), len, false);
+  }
+
+  bool isUsed(uint16_t key, size_t len) override {
+    if (key + len > Size) return false;
+    for (size_t i = 0; i < len; ++i) {
+      if (bytes[key + i] != 0xFF) return true;
+    }
+    return false;
+  }
+
+  bool clear(uint16_t key, size_t len) override {
+    if (key + len > Size) return false;
+    ++clears;
+    return store(key, nullptr, len, true);
+  }
+
+  /// Highest per-byte write count within [key, key + len).
+  uint32_t maxCellWrites(uint16_t key, size_t len) const {
+    uint32_t result = 0;
+    for (size_t i = 0; i < len; ++i) {
+      if (cellWrites[key + i] > result) result = cellWrites[key + i];
+    }
+    return result;
+  }
+
+  // Inspectable state
+  uint8_t bytes[Size];
+  uint32_t cellWrites[Size];
+  uint32_t reads = 0;
+  uint32_t writes = 0;
+  uint32_t clears = 0;
+  uint32_t bytesWritten = 0;
+  /// Bytes that may still be written; -1 = unlimited. Writes beyond the
+  /// budget are dropped (a torn write) and the call returns false.
+  int32_t writeBudget = -1;
+
+ private:
+  bool store(uint16_t key, const uint8_t* data, size_t len, bool erase) {
+    for (size_t i = 0; i < len; ++i) {
+      if (writeBudget == 0) return false;
+      if (writeBudget > 0) --writeBudget;
+      const uint8_t value = erase ? 0xFF : data[i];
+      if (bytes[key + i] != value) {
+        bytes[key + i] = value;
+        ++cellWrites[key + i];
+        ++bytesWritten;
+      }
+    }
+    return true;
+  }
+};
@@ -0,0 +1,183 @@
+#pragma once
+#include <Arduino.h>
+#include <string.h>
+
+/**
+ * Fake I2C bus with an HD44780-behind-PCF8574 panel attached.
+ *
+ * Counts transmissions and bytes, and decodes the expander writes
+ * (P0 = RS, P2 = EN, P3 = backlight, P4..P7 = D4..D7) into the panel's
+ * display RAM so tests can check both traffic and what is shown.
+ */
+class FakeTwoWire {
+ public:
+  static constexpr uint8_t BufferLength = 32;
+
+  FakeTwoWire() { reset(); }
+
+  // --- TwoWire API used by the driver ---
+  void begin() { begun = true; }
+  void begin(int, int) { begun = true; }
+  void setClock(uint32_t hz) { clockHz = hz; }
+
+  void beginTransmission(uint8_t addr) {
+    target = addr;
+    length = 0;
+  }
+
+  size_t write(uint8_t value) {
+    if (length >= BufferLength) {
+      ++overflows;
+      return 0;
+    }
+    buffer[length++] = value;
+    return 1;
+  }
+
+  uint8_t endTransmission(bool = true) {
+    ++transmissions;
+    if (!present || target != address) return 2;  // address NACK
+    bytesSent += length;
+    for (uint8_t i = 0; i < length; ++i) expanderWrite(buffer[i]);
+    return 0;
+  }
+
+  // --- Test configuration ---
+  bool present = true;     ///< Whether the panel ACKs its address.
+  uint8_t address = 0x27;  ///< Address the panel answers on.
+  uint8_t cols = 16;
+  uint8_t rows = 2;
+
+  /// Power-cycle the panel and clear every counter.
+  void reset() {
+    memset(ddram, ' ', sizeof(ddram));
+    eightBit = true;
+    haveHighNibble = false;
+    lastOutput = 0;
+    addr = 0;
+    backlightOn = false;
+    displayOn = false;
+    twoLine = false;
+    begun = false;
+    clockHz = 100000;
+    resetCounters();
+  }
+
+  void resetCounters() {
+    transmissions = 0;
+    bytesSent = 0;
+    overflows = 0;
+    clearCalls = 0;
+    setCursorCalls = 0;
+    charsWritten = 0;
+  }
+
+  /// Row as shown on the panel, null-terminated.
+  const char* row(uint8_t r) {
+    memcpy(rowText, &ddram[rowOffset(r)], cols);
+    rowText[cols] = '\0';
+    return rowText;
+  }
+
+  uint8_t cursorRow() const {
+    for (uint8_t r = 0; r < rows; ++r) {
+      if (addr >= rowOffset(r) && addr < rowOffset(r) + cols) return r;
+    }
+    return 255;
+  }
+
+  uint8_t cursorCol() const {
+    const uint8_t r = cursorRow();
+    return r == 255 ? 255 : static_cast<uint8_t>(addr - rowOffset(r));
+  }
+
+  // --- Inspectable state ---
+  bool begun;
+  uint32_t clockHz;
+  uint32_t transmissions;
+  uint32_t bytesSent;
+  uint32_t overflows;
+  uint32_t clearCalls;      ///< Clear-display commands decoded.
+  uint32_t setCursorCalls;  ///< Set-DDRAM-address commands decoded.
+  uint32_t charsWritten;    ///< Data bytes decoded.
+  bool backlightOn;
+  bool displayOn;
+  bool twoLine;
+  bool eightBit;
+
+ private:
+  uint8_t target = 0;
+  uint8_t buffer[BufferLength];
+  uint8_t length = 0;
+
+  char ddram[128];
+  char rowText[41];
+  uint8_t addr;
+  uint8_t lastOutput;
+  bool haveHighNibble;
+  uint8_t highNibble;
+
+  // Rows 2 and 3 continue rows 0 and 1 in display RAM.
+  uint8_t rowOffset(uint8_t r) const {
+    return static_cast<uint8_t>((r & 1 ? 0x40 : 0x00) + (r & 2 ? cols : 0));
+  }
+
+  void expanderWrite(uint8_t value) {
+    backlightOn = value & 0x08;
+    // The HD44780 latches D4..D7 on the falling edge of EN.
+    const bool falling = (lastOutput & 0x04) && !(value & 0x04);
+    if (falling) latch(lastOutput >> 4, lastOutput & 0x01);
+    lastOutput = value;
+  }
+
+  void latch(uint8_t nibble, bool rs) {
+    if (eightBit) {
+      execute(static_cast<uint8_t>(nibble << 4), rs);
+      return;
+    }
+    if (!haveHighNibble) {
+      highNibble = nibble;
+      haveHighNibble = true;
+      return;
+    }
+    haveHighNibble = false;
+    execute(static_cast<uint8_t>(highNibble << 4 | nibble), rs);
+  }
+
+  void execute(uint8_t value, bool rs) {
+    if (rs) {
+      ++charsWritten;
+      ddram[addr & 0x7F] = static_cast<char>(value);
+      addr = static_cast<uint8_t>((addr + 1) & 0x7F);
+      return;
+    }
+    // The highest set bit selects the instruction.
+    if (value & 0x80) {
+      ++setCursorCalls;
+      addr = value & 0x7F;
+    } else if (value & 0x40) {
+      // Set CGRAM address: custom characters are not emulated.
+    } else if (value & 0x20) {
+      eightBit = value & 0x10;
+      twoLine = value & 0x08;
+    } else if (value & 0x10) {
+      // Cursor/display shift: not emulated.
+    } else if (value & 0x08) {
+      displayOn = value & 0x04;
+    } else if (value & 0x04) {
+      // Entry mode: the driver always uses left-to-right increment.
+    } else if (value & 0x02) {
+      addr = 0;
+    } else if (value & 0x01) {
+      ++clearCalls;
+      memset(ddram, ' ', sizeof(ddram));
+      addr = 0;
+    }
+  }
+};
+
+/// The bus LCD drivers use in test builds, standing in for Wire.
+inline FakeTwoWire& fakeWire() {
+  static FakeTwoWire bus;
+  return bus;
+}
@@ -0,0 +1,182 @@
+#ifndef ARDUINOCOMMON_FAKES_NATIVE_ARDUINO_H
+#define ARDUINOCOMMON_FAKES_NATIVE_ARDUINO_H
+
+/**
+ * @file
+ * @brief Minimal Arduino core for the [env:native] host build.
+ *
+ * Provides just enough of the Arduino API for the library and its tests
+ * to compile and run on a desktop: Print/Stream, a Serial that writes to
+ * stdout, a fake clock and settable analog inputs. Time does not pass on
+ * its own; delay() and delayMicroseconds() advance it.
+ *
+ * Only on the include path of the native environment, so it never
+ * shadows a board's real core.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define DEC 10
+#define HEX 16
+
+// Uno-style pin numbering: 14 digital pins followed by A0..A5.
+#define NUM_DIGITAL_PINS 20
+#define NUM_ANALOG_INPUTS 6
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define SDA A4
+#define SCL A5
+#define LED_BUILTIN 13
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t*>(addr))
+
+class __FlashStringHelper;
+#define F(text) (reinterpret_cast<const __FlashStringHelper*>(text))
+
+#define noInterrupts()
+#define interrupts()
+
+#define constrain(x, low, high) \
+  ((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+
+template <typename T>
+const T& min(const T& a, const T& b) {
+  return b < a ? b : a;
+}
+
+template <typename T>
+const T& max(const T& a, const T& b) {
+  return a < b ? b : a;
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+/**
+ * @brief Byte sink with the Arduino print()/println() overloads.
+ */
+class Print {
+ public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    for (size_t i = 0; i < size; ++i) write(buffer[i]);
+    return size;
+  }
+
+  size_t print(const char* text) {
+    return text ? write(reinterpret_cast<const uint8_t*>(text), strlen(text))
+                : 0;
+  }
+  size_t print(const __FlashStringHelper* text) {
+    return print(reinterpret_cast<const char*>(text));
+  }
+  size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+  size_t print(long value, int base = DEC) {
+    char text[24];
+    snprintf(text, sizeof(text), base == HEX ? "%lX" : "%ld", value);
+    return print(text);
+  }
+  size_t print(unsigned long value, int base = DEC) {
+    char text[24];
+    snprintf(text, sizeof(text), base == HEX ? "%lX" : "%lu", value);
+    return print(text);
+  }
+  size_t print(int value, int base = DEC) {
+    return print(static_cast<long>(value), base);
+  }
+  size_t print(unsigned int value, int base = DEC) {
+    return print(static_cast<unsigned long>(value), base);
+  }
+  size_t print(unsigned char value, int base = DEC) {
+    return print(static_cast<unsigned long>(value), base);
+  }
+  size_t print(double value, int digits = 2) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.*f", digits, value);
+    return print(text);
+  }
+
+  size_t println() { return print("\r\n"); }
+
+  template <typename T>
+  size_t println(T value) {
+    const size_t n = print(value);
+    return n + println();
+  }
+
+  template <typename T>
+  size_t println(T value, int format) {
+    const size_t n = print(value, format);
+    return n + println();
+  }
+};
+
+/**
+ * @brief Print with (empty) input.
+ */
+class Stream : public Print {
+ public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+  virtual void flush() {}
+};
+
+/**
+ * @brief Serial port that writes to stdout.
+ */
+class HostSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  explicit operator bool() const { return true; }
+
+  size_t write(uint8_t c) override {
+    putchar(c);
+    return 1;
+  }
+  using Print::write;
+};
+
+extern HostSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+/**
+ * @brief Value analogRead() returns for @p pin (host builds only).
+ */
+void hostSetAnalogValue(uint8_t pin, int value);
+
+#endif
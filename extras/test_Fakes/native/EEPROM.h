@@ -0,0 +1,64 @@
+#ifndef ARDUINOCOMMON_FAKES_NATIVE_EEPROM_H
+#define ARDUINOCOMMON_FAKES_NATIVE_EEPROM_H
+
+#include <Arduino.h>
+
+/**
+ * @brief AVR-style EEPROM library for the native environment.
+ *
+ * 1 KiB of RAM, erased (0xFF) at start-up; nothing persists between
+ * runs. Use MmapFileStorage for storage that does.
+ *
+ * Also has the buffer interface of the ESP32/ESP8266 cores (begin(),
+ * commit(), getDataPtr()), so EepromStorage's RAM-buffer path can be
+ * built on the host, and counts accesses for benchmarks.
+ */
+class EEPROMClass {
+ public:
+  static constexpr uint16_t Size = 1024;
+
+  EEPROMClass() { memset(bytes, 0xFF, sizeof(bytes)); }
+
+  uint8_t read(int address) const {
+    ++reads;
+    return inRange(address) ? bytes[address] : 0xFF;
+  }
+
+  void write(int address, uint8_t value) {
+    ++writes;
+    if (inRange(address)) bytes[address] = value;
+  }
+
+  void update(int address, uint8_t value) { write(address, value); }
+
+  uint16_t length() const { return Size; }
+
+  bool begin(size_t size) { return size <= Size; }
+
+  bool commit() {
+    ++commits;
+    return true;
+  }
+
+  uint8_t* getDataPtr() { return bytes; }
+
+  const uint8_t* getConstDataPtr() const { return bytes; }
+
+  /// Resets the access counters.
+  void resetCounters() { reads = writes = commits = 0; }
+
+  // Single-byte accesses through read() and write()/update(), and
+  // commit() calls.
+  mutable uint32_t reads = 0;
+  uint32_t writes = 0;
+  uint32_t commits = 0;
+
+ private:
+  uint8_t bytes[Size];
+
+  static bool inRange(int address) { return address >= 0 && address < Size; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,51 @@
+// Definitions for the native Arduino shim (see Arduino.h in this folder),
+// and a main() that runs an Arduino-style sketch or test once.
+
+#include <Arduino.h>
+#include <EEPROM.h>
+
+HostSerial Serial;
+EEPROMClass EEPROM;
+
+namespace {
+unsigned long hostMicros = 0;
+int analogValues[NUM_DIGITAL_PINS] = {};
+uint8_t digitalValues[NUM_DIGITAL_PINS] = {};
+}  // namespace
+
+unsigned long millis() { return hostMicros / 1000UL; }
+
+unsigned long micros() { return hostMicros; }
+
+void delay(unsigned long ms) { hostMicros += ms * 1000UL; }
+
+void delayMicroseconds(unsigned int us) { hostMicros += us; }
+
+void yield() {}
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < NUM_DIGITAL_PINS) digitalValues[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < NUM_DIGITAL_PINS ? digitalValues[pin] : LOW;
+}
+
+int analogRead(uint8_t pin) {
+  return pin < NUM_DIGITAL_PINS ? analogValues[pin] : 0;
+}
+
+void hostSetAnalogValue(uint8_t pin, int value) {
+  if (pin < NUM_DIGITAL_PINS) analogValues[pin] = value;
+}
+
+void setup();
+void loop();
+
+int main() {
+  setup();
+  loop();
+  return 0;
+}
@@ -1,6 +1,11 @@
 #pragma
 
 #include "ArduinoCommon/Utils/PinManager.h"
+#include "ArduinoCommon/Utils/I2cBusManager.h"
 #include "ArduinoCommon/Sensors/SOILSENSOR.h"
+#include "ArduinoCommon/Sensors/SensorGroup.h"
+#include "ArduinoCommon/Sensors/FilteredSensor.h"
+#include "ArduinoCommon/Sensors/StaticSoilSensor.h"
+#include "ArduinoCommon/Sensors/SensorHistory.h"
 #include "ArduinoCommon/Display/LCD1602.h"
 #include "ArduinoCommon/Pumps/PumpController.h"
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef ARDUINOCOMMON_CONFIG_ATOMICSTORAGE_H
+#define ARDUINOCOMMON_CONFIG_ATOMICSTORAGE_H
+
+#include <Arduino.h>
+#include "IConfigStorage.h"
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief Header at the start of each AtomicStorage slot.
+ */
+struct SlotHeader {
+  uint32_t sequence;    ///< Incremented by every commit.
+  uint16_t payloadCrc;  ///< CRC-16 of the slot's data.
+  uint16_t headerCrc;   ///< CRC-16 of sequence and payloadCrc.
+};
+
+/**
+ * @brief Power-loss-safe A/B storage on top of another IConfigStorage.
+ *
+ * Keeps two copies (slots) of a region of @p size bytes. Reads come from
+ * the active slot. Every write() or clear() is committed atomically:
+ *  1. the new contents are written to the inactive slot, where only the
+ *     bytes that differ from its old contents are rewritten (on top of
+ *     EepromStorage this is EEPROM.update() semantics);
+ *  2. the slot's header is written last, with the next sequence number.
+ * If power fails before the header is complete, its CRC does not match
+ * and the previous slot stays active, so a half-written struct is never
+ * visible.
+ *
+ * At begin() the selector reads the two headers (one read each) and
+ * picks the newest one with a valid header CRC; no data is scanned.
+ * verify() additionally checks the active data against its CRC.
+ *
+ * Each commit streams the whole region through a small stack buffer, so
+ * no RAM copy is kept; keep regions small (tens to a few hundred bytes).
+ *
+ * Typical usage:
+ * @code
+ * EepromStorage eeprom(256);
+ * AtomicStorage config(eeprom, 0, 64);  // 64 bytes, uses 2 * (8 + 64)
+ *
+ * void setup() {
+ *   config.begin();
+ *   soil.attachStorage(&config, 0);
+ * }
+ * @endcode
+ */
+class AtomicStorage : public IConfigStorage {
+ public:
+  static constexpr uint16_t HeaderSize = sizeof(SlotHeader);
+
+  /**
+   * @brief Use two slots of @p size bytes starting at @p base.
+   *
+   * Occupies requiredSize(size) bytes of @p backing.
+   */
+  AtomicStorage(IConfigStorage& backing, uint16_t base, uint16_t size);
+
+  /// Backing bytes needed for a logical size.
+  static constexpr uint16_t requiredSize(uint16_t size) {
+    return static_cast<uint16_t>(2 * (HeaderSize + size));
+  }
+
+  /**
+   * @brief Select the newest valid slot.
+   *
+   * @return true  If a valid slot was found.
+   * @return false If neither slot is valid (e.g. first boot); the
+   *               storage then reads as erased (all 0xFF).
+   */
+  bool begin();
+
+  /**
+   * @brief Check the active slot's data against its CRC.
+   */
+  bool verify();
+
+  bool read(uint16_t key, void* data, size_t len) override;
+
+  /**
+   * @brief Change bytes and commit the result to the inactive slot.
+   *
+   * A write that changes nothing does not commit.
+   */
+  bool write(uint16_t key, const void* data, size_t len) override;
+
+  bool isUsed(uint16_t key, size_t len) override;
+
+  bool clear(uint16_t key, size_t len) override;
+
+  /// Slot holding the current data (0 or 1), or -1 if none is valid.
+  int8_t activeSlot() const { return _active; }
+
+  /// Sequence number of the active slot.
+  uint32_t sequence() const { return _sequence; }
+
+  /// Logical size in bytes.
+  uint16_t size() const { return _size; }
+
+ private:
+  IConfigStorage& _backing;
+  uint16_t _base;
+  uint16_t _size;
+  int8_t _active = -1;
+  uint32_t _sequence = 0;
+
+  uint16_t slotStart(uint8_t slot) const {
+    return static_cast<uint16_t>(_base + slot * (HeaderSize + _size));
+  }
+
+  static uint16_t headerCrc(const SlotHeader& header);
+
+  /// Read current bytes; erased (0xFF) when no slot is active.
+  bool readCurrent(uint16_t offset, uint8_t* data, uint16_t len);
+
+  /// Commit current contents with [key, key + len) replaced by data
+  /// (or 0xFF if data is null).
+  bool commit(uint16_t key, const uint8_t* data, uint16_t len);
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef ARDUINOCOMMON_CONFIG_CACHEDSTORAGE_H
+#define ARDUINOCOMMON_CONFIG_CACHEDSTORAGE_H
+
+#include <Arduino.h>
+#include <string.h>
+#include "IConfigStorage.h"
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief RAM write-back cache in front of another IConfigStorage.
+ *
+ * Keeps a copy of @p Size bytes of the backing storage in RAM. Reads are
+ * served from the copy; writes only update it and extend a dirty range.
+ * The dirty range is written back in a single backing write() when
+ *  - flush() is called,
+ *  - no write happened for the idle timeout, or
+ *  - the oldest unflushed change reaches the maximum delay,
+ * with the timeouts checked by update() from loop().
+ *
+ * On ESP32/SAMD every EepromStorage::write() ends in EEPROM.commit(), a
+ * full flash sector erase and program. Behind a CachedStorage, saving
+ * the configuration of ten sensors costs one commit instead of ten.
+ * Clean bytes inside the dirty range are rewritten unchanged, which
+ * EEPROM.update() skips and which the sector commit covers anyway.
+ *
+ * Typical usage:
+ * @code
+ * EepromStorage eeprom(512);
+ * CachedStorage<64> config(eeprom);  // caches bytes 0..63
+ *
+ * void setup() {
+ *   config.begin();
+ *   for (auto& sensor : sensors) sensor.attachStorage(&config, ...);
+ *   ...
+ *   config.flush();  // one commit
+ * }
+ *
+ * void loop() { config.update(); }
+ * @endcode
+ *
+ * Changes that have not been flushed are lost on power loss.
+ *
+ * @tparam Size Number of cached bytes.
+ */
+template <uint16_t Size>
+class CachedStorage : public IConfigStorage {
+  static_assert(Size > 0, "CachedStorage: Size must be > 0.");
+
+ private:
+  IConfigStorage& _backing;
+  uint16_t _base;
+  uint32_t _idleMs;
+  uint32_t _maxDelayMs;
+  uint8_t _cache[Size];
+
+  uint16_t _dirtyBegin = 0;
+  uint16_t _dirtyEnd = 0;  ///< Exclusive; equal to _dirtyBegin when clean.
+  uint32_t _firstChangeMs = 0;
+  uint32_t _lastChangeMs = 0;
+  uint32_t _flushes = 0;
+  bool _ready = false;
+
+  void markDirty(uint16_t begin, uint16_t end) {
+    const uint32_t now = millis();
+    if (!dirty()) {
+      _dirtyBegin = begin;
+      _dirtyEnd = end;
+      _firstChangeMs = now;
+    } else {
+      if (begin < _dirtyBegin) _dirtyBegin = begin;
+      if (end > _dirtyEnd) _dirtyEnd = end;
+    }
+    _lastChangeMs = now;
+  }
+
+ public:
+  /**
+   * @brief Cache bytes [base, base + Size) of another storage.
+   *
+   * @param backing    Storage to cache; keys passed to this object are
+   *                   offsets from @p base.
+   * @param base       First cached byte in @p backing.
+   * @param idleMs     Flush after this long without writes; 0 disables.
+   * @param maxDelayMs Flush at the latest this long after the first
+   *                   unflushed change; 0 disables.
+   */
+  explicit CachedStorage(IConfigStorage& backing, uint16_t base = 0,
+                         uint32_t idleMs = 1000, uint32_t maxDelayMs = 10000)
+      : _backing(backing),
+        _base(base),
+        _idleMs(idleMs),
+        _maxDelayMs(maxDelayMs) {
+    memset(_cache, 0xFF, sizeof(_cache));
+  }
+
+  /**
+   * @brief Write back pending changes.
+   */
+  ~CachedStorage() override { flush(); }
+
+  CachedStorage(const CachedStorage&) = delete;
+  CachedStorage& operator=(const CachedStorage&) = delete;
+
+  /**
+   * @brief Load the cached range from the backing storage.
+   *
+   * @return true  If the range could be read.
+   * @return false If the backing storage rejected the read.
+   */
+  bool begin() {
+    _dirtyBegin = _dirtyEnd = 0;
+    _ready = _backing.read(_base, _cache, Size);
+    return _ready;
+  }
+
+  /**
+   * @brief Set the automatic flush timeouts (0 disables either).
+   */
+  void setFlushPolicy(uint32_t idleMs, uint32_t maxDelayMs) {
+    _idleMs = idleMs;
+    _maxDelayMs = maxDelayMs;
+  }
+
+  bool read(uint16_t key, void* data, size_t len) override {
+    if (!_ready || key + len > Size) return false;
+    memcpy(data, _cache + key, len);
+    return true;
+  }
+
+  /**
+   * @brief Update the cache; bytes that do not change are not marked dirty.
+   */
+  bool write(uint16_t key, const void* data, size_t len) override {
+    if (!_ready || key + len > Size) return false;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    size_t first = 0;
+    while (first < len && _cache[key + first] == bytes[first]) ++first;
+    if (first == len) return true;
+    size_t last = len - 1;
+    while (_cache[key + last] == bytes[last]) --last;
+
+    memcpy(_cache + key + first, bytes + first, last - first + 1);
+    markDirty(static_cast<uint16_t>(key + first),
+              static_cast<uint16_t>(key + last + 1));
+    return true;
+  }
+
+  bool isUsed(uint16_t key, size_t len) override {
+    if (!_ready || key + len > Size) return false;
+    for (size_t i = 0; i < len; ++i) {
+      if (_cache[key + i] != 0xFF) return true;
+    }
+    return false;
+  }
+
+  bool clear(uint16_t key, size_t len) override {
+    if (!_ready || key + len > Size) return false;
+    size_t first = 0;
+    while (first < len && _cache[key + first] == 0xFF) ++first;
+    if (first == len) return true;
+    size_t last = len - 1;
+    while (_cache[key + last] == 0xFF) --last;
+
+    memset(_cache + key + first, 0xFF, last - first + 1);
+    markDirty(static_cast<uint16_t>(key + first),
+              static_cast<uint16_t>(key + last + 1));
+    return true;
+  }
+
+  /**
+   * @brief Write the dirty range back in one backing write().
+   *
+   * @return true  If nothing was pending or the write-back succeeded.
+   * @return false If the backing storage rejected the write; the range
+   *               stays dirty and is retried on the next flush.
+   */
+  bool flush() {
+    if (!dirty()) return true;
+    if (!_backing.write(_base + _dirtyBegin, _cache + _dirtyBegin,
+                        _dirtyEnd - _dirtyBegin)) {
+      return false;
+    }
+    _dirtyBegin = _dirtyEnd = 0;
+    ++_flushes;
+    return true;
+  }
+
+  /**
+   * @brief Flush if the idle timeout or the maximum delay has expired.
+   *
+   * Call regularly from loop().
+   */
+  void update() {
+    if (!dirty()) return;
+    const uint32_t now = millis();
+    const bool idle = _idleMs != 0 && now - _lastChangeMs >= _idleMs;
+    const bool overdue =
+        _maxDelayMs != 0 && now - _firstChangeMs >= _maxDelayMs;
+    if (idle || overdue) flush();
+  }
+
+  /// Whether there are unflushed changes.
+  bool dirty() const { return _dirtyEnd != _dirtyBegin; }
+
+  /// First dirty byte (valid while dirty()).
+  uint16_t dirtyBegin() const { return _dirtyBegin; }
+
+  /// One past the last dirty byte (valid while dirty()).
+  uint16_t dirtyEnd() const { return _dirtyEnd; }
+
+  /// Number of successful write-backs.
+  uint32_t flushCount() const { return _flushes; }
+
+  /// Cached size in bytes.
+  static constexpr uint16_t size() { return Size; }
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
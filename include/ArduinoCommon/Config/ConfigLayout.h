@@ -0,0 +1,194 @@
+#ifndef ARDUINOCOMMON_CONFIG_CONFIGLAYOUT_H
+#define ARDUINOCOMMON_CONFIG_CONFIGLAYOUT_H
+
+#include <Arduino.h>
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief A raw region of @p Bytes bytes for a ConfigLayout.
+ *
+ * For storage that is not described by a component type, e.g.
+ * ConfigBytes<AtomicStorage::requiredSize(32)>, or
+ * ConfigBytes<SoilSensor::CurveStorageSize> for a sensor that persists
+ * a calibration curve.
+ */
+template <uint16_t Bytes, uint16_t Align = 1>
+struct ConfigBytes {
+  static constexpr uint16_t StorageSize = Bytes;
+  static constexpr uint16_t StorageAlign = Align;
+};
+
+namespace detail {
+
+template <typename T>
+struct HasStorageSize {
+  template <typename U>
+  static char test(decltype(&U::StorageSize));
+  template <typename U>
+  static long test(...);
+  static constexpr bool value = sizeof(test<T>(nullptr)) == 1;
+};
+
+template <typename T>
+struct HasStorageAlign {
+  template <typename U>
+  static char test(decltype(&U::StorageAlign));
+  template <typename U>
+  static long test(...);
+  static constexpr bool value = sizeof(test<T>(nullptr)) == 1;
+};
+
+template <typename T, bool = HasStorageSize<T>::value>
+struct FootprintSize {
+  static constexpr uint32_t value = sizeof(T);
+};
+
+template <typename T>
+struct FootprintSize<T, true> {
+  static constexpr uint32_t value = T::StorageSize;
+};
+
+template <typename T, bool = HasStorageAlign<T>::value>
+struct FootprintAlign {
+  static constexpr uint32_t value = 1;
+};
+
+template <typename T>
+struct FootprintAlign<T, true> {
+  static constexpr uint32_t value = T::StorageAlign;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Storage bytes and alignment a component needs in a ConfigLayout.
+ *
+ * A component declares its footprint with static constexpr members:
+ *  - StorageSize: bytes to reserve (e.g. SoilSensor::StorageSize);
+ *    without it, sizeof(T) is used, so plain record structs work as is;
+ *  - StorageAlign: optional offset alignment (default 1, i.e. packed).
+ * Specialize this template for types that cannot be changed.
+ */
+template <typename T>
+struct ConfigFootprint {
+  static constexpr uint32_t size = detail::FootprintSize<T>::value;
+  static constexpr uint32_t align = detail::FootprintAlign<T>::value;
+  static_assert(align > 0, "ConfigFootprint: StorageAlign must be > 0.");
+};
+
+namespace detail {
+
+constexpr uint32_t alignUp(uint32_t offset, uint32_t align) {
+  return (offset + align - 1) / align * align;
+}
+
+template <uint32_t Offset, typename... Components>
+struct LayoutNode;
+
+template <uint32_t Offset>
+struct LayoutNode<Offset> {
+  static constexpr uint32_t end = Offset;
+};
+
+template <uint32_t Offset, typename T, typename... Rest>
+struct LayoutNode<Offset, T, Rest...> {
+  static constexpr uint32_t start =
+      alignUp(Offset, ConfigFootprint<T>::align);
+  static constexpr uint32_t size = ConfigFootprint<T>::size;
+  typedef LayoutNode<start + size, Rest...> Next;
+  static constexpr uint32_t end = Next::end;
+};
+
+template <size_t Index, typename Node>
+struct LayoutAt {
+  typedef typename LayoutAt<Index - 1, typename Node::Next>::Type Type;
+};
+
+template <typename Node>
+struct LayoutAt<0, Node> {
+  typedef Node Type;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Compile-time allocation of storage regions.
+ *
+ * Lists every component that persists data, in order, and assigns each
+ * one a non-overlapping offset. Offsets are packed: the only gaps are
+ * those a component asks for with StorageAlign. Everything is computed
+ * by the compiler, so there is no runtime bookkeeping, and a layout
+ * that does not fit in @p Capacity bytes fails to compile.
+ *
+ * Regions are assigned in declaration order, so append new components
+ * at the end to keep existing data where it is across firmware updates.
+ *
+ * Typical usage:
+ * @code
+ * struct Settings { uint16_t intervalS; uint8_t flags; };
+ *
+ * using Layout = ConfigLayout<512, SoilSensor, SoilSensor, Settings>;
+ *
+ * EepromStorage eeprom(Layout::capacity());
+ * SoilSensor soilA(A0), soilB(A1);
+ *
+ * void setup() {
+ *   soilA.attachStorage(&eeprom, Layout::offset<0>());
+ *   soilB.attachStorage(&eeprom, Layout::offset<1>());
+ *   eeprom.read(Layout::offset<2>(), &settings, sizeof(settings));
+ * }
+ * @endcode
+ *
+ * @tparam Capacity   Size of the storage the layout must fit in, e.g.
+ *                    the size passed to EepromStorage.
+ * @tparam Components Component types (see ConfigFootprint).
+ */
+template <uint32_t Capacity, typename... Components>
+class ConfigLayout {
+ private:
+  typedef detail::LayoutNode<0, Components...> Root;
+
+  template <size_t Index>
+  struct Entry {
+    static_assert(Index < sizeof...(Components),
+                  "ConfigLayout: component index out of range.");
+    typedef typename detail::LayoutAt<Index, Root>::Type Type;
+  };
+
+  static_assert(Root::end <= Capacity,
+                "ConfigLayout: components do not fit in the storage.");
+  static_assert(Capacity <= 0x10000UL,
+                "ConfigLayout: IConfigStorage keys are 16 bits.");
+
+ public:
+  /// Number of components.
+  static constexpr size_t count() { return sizeof...(Components); }
+
+  /// Storage offset of component @p Index (its storage key).
+  template <size_t Index>
+  static constexpr uint16_t offset() {
+    return static_cast<uint16_t>(Entry<Index>::Type::start);
+  }
+
+  /// Bytes reserved for component @p Index.
+  template <size_t Index>
+  static constexpr uint16_t sizeOf() {
+    return static_cast<uint16_t>(Entry<Index>::Type::size);
+  }
+
+  /// First byte after the last component.
+  static constexpr uint32_t size() { return Root::end; }
+
+  /// Capacity the layout was checked against.
+  static constexpr uint32_t capacity() { return Capacity; }
+
+  /// Bytes left after the last component.
+  static constexpr uint32_t freeBytes() { return Capacity - Root::end; }
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef ARDUINOCOMMON_CONFIG_CONFIGRECORD_H
+#define ARDUINOCOMMON_CONFIG_CONFIGRECORD_H
+
+#include <Arduino.h>
+#include "IConfigStorage.h"
+
+#ifndef ARDUINOCOMMON_CONFIG_RECORD_BUFFER
+#define ARDUINOCOMMON_CONFIG_RECORD_BUFFER 80
+#endif
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief Header in front of every framed record.
+ *
+ * The CRC covers type, length, version and the payload. It does not
+ * cover flags, so a flag bit can later be cleared (1 -> 0) in place
+ * without rewriting the record.
+ */
+struct RecordHeader {
+  uint16_t magic;   ///< ConfigRecord::Magic; 0xFFFF when erased.
+  uint16_t type;    ///< Caller-defined record type.
+  uint16_t length;  ///< Payload length in bytes.
+  uint8_t version;  ///< Caller-defined payload layout version.
+  uint8_t flags;    ///< Not covered by the CRC; 0xFF when written.
+  uint16_t crc;     ///< CRC-16/CCITT-FALSE, see Crc16.
+};
+
+/**
+ * @brief Result of reading or validating a record.
+ */
+enum class RecordStatus : uint8_t {
+  Ok,            ///< Header and payload are intact.
+  Empty,         ///< Erased (or never written).
+  Corrupt,       ///< Bad magic or CRC mismatch, e.g. a torn write.
+  WrongType,     ///< Intact record of another type (or size).
+  TooLarge,      ///< Payload larger than the caller's buffer.
+  StorageError,  ///< The storage rejected the access.
+};
+
+/**
+ * @brief Typed, CRC-protected records on top of IConfigStorage.
+ *
+ * A record is a RecordHeader followed by the payload. Instead of
+ * IConfigStorage::isUsed(), which scans every byte and cannot tell an
+ * empty slot from a corrupt one, a reader fetches the header with a
+ * single read, checks magic, type and length, reads the payload and
+ * verifies the CRC. A write torn by a power loss is reported as
+ * RecordStatus::Corrupt rather than returned as data.
+ *
+ * Records may be stored back to back; scan() then validates all of them
+ * in one pass at boot.
+ */
+class ConfigRecord {
+ public:
+  static constexpr uint16_t Magic = 0x5243;  // "CR"
+  static constexpr uint16_t HeaderSize = sizeof(RecordHeader);
+
+  /// Summary of a record, passed to scan() visitors.
+  struct Info {
+    uint16_t key;      ///< Storage offset of the header.
+    uint16_t type;
+    uint16_t length;
+    uint8_t version;
+    uint8_t flags;
+  };
+
+  using Visitor = void (*)(const Info& info, void* context);
+
+  /// Bytes a record with @p length bytes of payload occupies.
+  static constexpr uint16_t storedSize(uint16_t length) {
+    return static_cast<uint16_t>(HeaderSize + length);
+  }
+
+  /**
+   * @brief Write a record.
+   *
+   * Records up to ARDUINOCOMMON_CONFIG_RECORD_BUFFER bytes are written
+   * with a single storage write; larger ones payload first, then header.
+   *
+   * @return true If the storage accepted the write.
+   */
+  static bool write(IConfigStorage& storage, uint16_t key, uint16_t type,
+                    uint8_t version, const void* data, uint16_t length);
+
+  /**
+   * @brief Read and verify a record.
+   *
+   * @param data     Receives the payload; its contents are unspecified
+   *                 unless RecordStatus::Ok is returned.
+   * @param capacity Size of @p data.
+   * @param info     Optional; receives the header fields when the header
+   *                 is intact.
+   */
+  static RecordStatus read(IConfigStorage& storage, uint16_t key,
+                           uint16_t type, void* data, uint16_t capacity,
+                           Info* info = nullptr);
+
+  /**
+   * @brief Validate a record without copying out its payload.
+   */
+  static RecordStatus validate(IConfigStorage& storage, uint16_t key,
+                               Info* info = nullptr);
+
+  /**
+   * @brief Erase a record by clearing its header.
+   */
+  static bool erase(IConfigStorage& storage, uint16_t key) {
+    return storage.clear(key, HeaderSize);
+  }
+
+  /**
+   * @brief Validate back-to-back records in [begin, end) in one pass.
+   *
+   * Stops at the first empty or corrupt header, since the length of a
+   * corrupt record cannot be trusted.
+   *
+   * @param visit   Optional; called for every intact record.
+   * @param stopKey Optional; receives the offset where the scan stopped
+   *                (the first free byte if the region is intact).
+   * @return RecordStatus Ok if the scan ended at an empty header or at
+   *         @p end, otherwise the status of the offending record.
+   */
+  static RecordStatus scan(IConfigStorage& storage, uint16_t begin,
+                           uint16_t end, Visitor visit = nullptr,
+                           void* context = nullptr,
+                           uint16_t* stopKey = nullptr);
+
+  /**
+   * @brief Write a fixed-size value as a record.
+   */
+  template <typename T>
+  static bool writeValue(IConfigStorage& storage, uint16_t key, uint16_t type,
+                         uint8_t version, const T& value) {
+    return write(storage, key, type, version, &value, sizeof(T));
+  }
+
+  /**
+   * @brief Read a fixed-size value; the stored length must match,
+   * otherwise RecordStatus::WrongType is returned.
+   *
+   * @param version Optional; receives the stored version.
+   */
+  template <typename T>
+  static RecordStatus readValue(IConfigStorage& storage, uint16_t key,
+                                uint16_t type, T& value,
+                                uint8_t* version = nullptr) {
+    T tmp;
+    Info info;
+    const RecordStatus status =
+        read(storage, key, type, &tmp, sizeof(T), &info);
+    if (status != RecordStatus::Ok) return status;
+    if (info.length != sizeof(T)) return RecordStatus::WrongType;
+    value = tmp;
+    if (version) *version = info.version;
+    return RecordStatus::Ok;
+  }
+
+ private:
+  static uint16_t headerCrc(const RecordHeader& header);
+  static RecordStatus readHeader(IConfigStorage& storage, uint16_t key,
+                                 RecordHeader& header);
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,437 @@
+#ifndef ARDUINOCOMMON_CONFIG_CONFIGSTORE_H
+#define ARDUINOCOMMON_CONFIG_CONFIGSTORE_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <string.h>
+#include "ConfigRecord.h"
+#include "IConfigStorage.h"
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief 16-bit key of a ConfigStore entry.
+ *
+ * Built implicitly from a name (hashed with FNV-1a, folded to 16 bits,
+ * at compile time for literals) or from a number used as-is:
+ * @code
+ * store.set("soil.0.cal", cal);     // hashed name
+ * store.set(0x0100 + index, cal);   // numeric key
+ * constexpr ConfigKey kPump("pump.interval");
+ * @endcode
+ *
+ * Only the hash is stored, so two names with the same hash refer to the
+ * same entry; compare ConfigKey(name).hash values to rule this out for
+ * a fixed key set.
+ */
+struct ConfigKey {
+  uint16_t hash;
+
+  constexpr ConfigKey(const char* name)
+      : hash(fold(fnv1a(name, 2166136261UL))) {}
+  constexpr ConfigKey(int value) : hash(static_cast<uint16_t>(value)) {}
+
+ private:
+  static constexpr uint32_t fnv1a(const char* s, uint32_t h) {
+    return *s ? fnv1a(s + 1, (h ^ static_cast<uint8_t>(*s)) * 16777619UL)
+              : h;
+  }
+  static constexpr uint16_t fold(uint32_t h) {
+    return static_cast<uint16_t>((h >> 16) ^ (h & 0xFFFF));
+  }
+};
+
+/**
+ * @brief Key-value store for configuration on top of IConfigStorage.
+ *
+ * Replaces hand-picked byte offsets with named entries. Values are
+ * stored as ConfigRecord records (type = key hash) appended back to back
+ * in a region of the storage, and may have any length.
+ *
+ * begin() validates the region in one pass (ConfigRecord::scan()) and
+ * builds an in-RAM hash index of key -> offset, so get()/set() never
+ * scan the storage. The index holds up to @p MaxKeys entries at 4 bytes
+ * per slot.
+ *
+ *  - set() appends a new record, then marks the old one deleted by
+ *    clearing a flag bit in place (not covered by the CRC). If power
+ *    fails in between, the newer record wins at the next begin().
+ *  - remove() only marks the record deleted.
+ *  - When the region is full, compact() slides live records to the front
+ *    and reclaims the space of deleted ones. Compaction rewrites records
+ *    in place; combine with an A/B scheme if it must survive power loss.
+ *
+ * Typical usage:
+ * @code
+ * EepromStorage eeprom(1024);
+ * ConfigStore<32> config(eeprom, 0, 1024);
+ *
+ * void setup() {
+ *   config.begin();
+ *   uint32_t interval = 60000;
+ *   config.get("pump.interval", interval);   // keeps default if missing
+ * }
+ * @endcode
+ *
+ * @tparam MaxKeys Maximum number of live keys.
+ */
+template <uint16_t MaxKeys>
+class ConfigStore {
+  static_assert(MaxKeys > 0 && MaxKeys <= 4096,
+                "ConfigStore: MaxKeys must be in [1,4096].");
+
+ public:
+  /// Flag bit that is cleared when a record is deleted or replaced.
+  static constexpr uint8_t LiveFlag = 0x01;
+  static constexpr uint8_t Version = 1;
+
+ private:
+  static constexpr uint16_t nextPow2(uint16_t v, uint16_t p = 1) {
+    return p >= v ? p : nextPow2(v, static_cast<uint16_t>(p * 2));
+  }
+
+  /// Slots in the open-addressing index; at most half full.
+  static constexpr uint16_t Slots = nextPow2(MaxKeys * 2);
+  static constexpr uint16_t Mask = Slots - 1;
+  static constexpr uint16_t EmptySlot = 0xFFFF;
+
+  struct Entry {
+    uint16_t hash;
+    uint16_t offset;  ///< Relative to _base; EmptySlot if unused.
+  };
+
+  IConfigStorage& _storage;
+  uint16_t _base;
+  uint16_t _size;
+  uint16_t _end = 0;        ///< First free byte (relative).
+  uint16_t _liveBytes = 0;  ///< Bytes used by live records.
+  uint16_t _count = 0;
+  bool _ready = false;
+  Entry _index[Slots];
+
+  static uint16_t home(uint16_t hash) {
+    // Mix the bits so sequential numeric keys spread out.
+    return static_cast<uint16_t>((hash * 40503u) >> 4) & Mask;
+  }
+
+  int find(uint16_t hash) const {
+    uint16_t i = home(hash);
+    for (uint16_t n = 0; n < Slots; ++n, i = (i + 1) & Mask) {
+      if (_index[i].offset == EmptySlot) return -1;
+      if (_index[i].hash == hash) return i;
+    }
+    return -1;
+  }
+
+  bool insert(uint16_t hash, uint16_t offset) {
+    const int existing = find(hash);
+    if (existing >= 0) {
+      _index[existing].offset = offset;
+      return true;
+    }
+    if (_count >= MaxKeys) return false;
+    uint16_t i = home(hash);
+    while (_index[i].offset != EmptySlot) i = (i + 1) & Mask;
+    _index[i] = Entry{hash, offset};
+    ++_count;
+    return true;
+  }
+
+  /// Remove slot i, shifting later entries of the probe run back.
+  void erase(uint16_t i) {
+    uint16_t hole = i;
+    uint16_t j = i;
+    for (;;) {
+      j = (j + 1) & Mask;
+      if (_index[j].offset == EmptySlot) break;
+      const uint16_t h = home(_index[j].hash);
+      // Move j into the hole unless its home lies cyclically in (hole, j].
+      const bool stays =
+          hole <= j ? (hole < h && h <= j) : (hole < h || h <= j);
+      if (!stays) {
+        _index[hole] = _index[j];
+        hole = j;
+      }
+    }
+    _index[hole].offset = EmptySlot;
+    --_count;
+  }
+
+  uint16_t recordLength(uint16_t offset) const {
+    RecordHeader header;
+    _storage.read(_base + offset, &header, ConfigRecord::HeaderSize);
+    return header.length;
+  }
+
+  bool markDeleted(uint16_t offset) {
+    RecordHeader header;
+    if (!_storage.read(_base + offset, &header, ConfigRecord::HeaderSize)) {
+      return false;
+    }
+    const uint8_t flags = static_cast<uint8_t>(header.flags & ~LiveFlag);
+    const uint16_t flagsOffset = offsetof(RecordHeader, flags);
+    return _storage.write(_base + offset + flagsOffset, &flags, 1);
+  }
+
+  static void indexRecord(const ConfigRecord::Info& info, void* context) {
+    ConfigStore* self = static_cast<ConfigStore*>(context);
+    if (!(info.flags & LiveFlag)) return;
+    const uint16_t offset = static_cast<uint16_t>(info.key - self->_base);
+    const int existing = self->find(info.type);
+    if (existing >= 0) {
+      // Left behind by an interrupted set(): the later record wins.
+      self->_liveBytes -= ConfigRecord::storedSize(
+          self->recordLength(self->_index[existing].offset));
+    }
+    if (self->insert(info.type, offset)) {
+      self->_liveBytes += ConfigRecord::storedSize(info.length);
+    }
+  }
+
+  /// Copy len bytes from src to dst (dst < src) in chunks.
+  bool move(uint16_t dst, uint16_t src, uint16_t len) {
+    uint8_t chunk[16];
+    for (uint16_t done = 0; done < len;) {
+      uint16_t n = static_cast<uint16_t>(len - done);
+      if (n > sizeof(chunk)) n = sizeof(chunk);
+      if (!_storage.read(_base + src + done, chunk, n) ||
+          !_storage.write(_base + dst + done, chunk, n)) {
+        return false;
+      }
+      done = static_cast<uint16_t>(done + n);
+    }
+    return true;
+  }
+
+  void clearIndex() {
+    for (uint16_t i = 0; i < Slots; ++i) _index[i].offset = EmptySlot;
+    _count = 0;
+    _liveBytes = 0;
+  }
+
+ public:
+  /**
+   * @brief Use bytes [base, base + size) of a storage for the store.
+   */
+  ConfigStore(IConfigStorage& storage, uint16_t base, uint16_t size)
+      : _storage(storage), _base(base), _size(size) {
+    clearIndex();
+  }
+
+  /**
+   * @brief Validate the region and build the index.
+   *
+   * A corrupt record (e.g. a write torn by a power loss) ends the scan;
+   * everything before it is kept and later writes overwrite it.
+   *
+   * @return true  If the region was read; records beyond MaxKeys or
+   *               after a corrupt record are ignored.
+   * @return false If the storage could not be read.
+   */
+  bool begin() {
+    clearIndex();
+    _ready = false;
+    uint16_t stop = 0;
+    const RecordStatus status = ConfigRecord::scan(
+        _storage, _base, static_cast<uint16_t>(_base + _size), indexRecord,
+        this, &stop);
+    if (status == RecordStatus::StorageError) return false;
+    _end = static_cast<uint16_t>(stop - _base);
+    _ready = true;
+    return true;
+  }
+
+  /**
+   * @brief Store a value under a key, replacing any previous value.
+   *
+   * Writing the same bytes again does not touch the storage.
+   *
+   * @return true  If the value was stored.
+   * @return false If the store is full (even after compaction), the
+   *               index has no room for a new key, or a write failed.
+   */
+  bool set(ConfigKey key, const void* data, uint16_t len) {
+    if (!_ready) return false;
+    const int slot = find(key.hash);
+    uint16_t oldLength = 0;
+    if (slot >= 0) {
+      oldLength = recordLength(_index[slot].offset);
+      if (oldLength == len) {
+        uint8_t chunk[16];
+        bool same = true;
+        const uint16_t start = _index[slot].offset + ConfigRecord::HeaderSize;
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (uint16_t done = 0; same && done < len;) {
+          uint16_t n = static_cast<uint16_t>(len - done);
+          if (n > sizeof(chunk)) n = sizeof(chunk);
+          same = _storage.read(_base + start + done, chunk, n) &&
+                 memcmp(chunk, bytes + done, n) == 0;
+          done = static_cast<uint16_t>(done + n);
+        }
+        if (same) return true;
+      }
+    } else if (_count >= MaxKeys) {
+      return false;
+    }
+
+    const uint16_t needed = ConfigRecord::storedSize(len);
+    if (static_cast<uint32_t>(_end) + needed > _size) {
+      // The old value stays live until the new one is written.
+      if (static_cast<uint32_t>(_liveBytes) + needed > _size) return false;
+      if (!compact()) return false;
+    }
+
+    const uint16_t offset = _end;
+    if (!ConfigRecord::write(_storage, _base + offset, key.hash, Version, data,
+                             len)) {
+      return false;
+    }
+    _end = static_cast<uint16_t>(_end + needed);
+
+    const int previous = find(key.hash);
+    if (previous >= 0) {
+      const uint16_t oldOffset = _index[previous].offset;
+      _liveBytes -= ConfigRecord::storedSize(recordLength(oldOffset));
+      markDeleted(oldOffset);
+    }
+    insert(key.hash, offset);
+    _liveBytes += needed;
+    return true;
+  }
+
+  /**
+   * @brief Read a value.
+   *
+   * @return int The stored length, or -1 if the key is missing, the
+   *             value does not fit @p capacity, or it fails its CRC.
+   */
+  int get(ConfigKey key, void* data, uint16_t capacity) {
+    const int slot = _ready ? find(key.hash) : -1;
+    if (slot < 0) return -1;
+    ConfigRecord::Info info;
+    const RecordStatus status =
+        ConfigRecord::read(_storage, _base + _index[slot].offset, key.hash,
+                           data, capacity, &info);
+    return status == RecordStatus::Ok ? info.length : -1;
+  }
+
+  /**
+   * @brief Store a fixed-size value.
+   */
+  template <typename T>
+  bool set(ConfigKey key, const T& value) {
+    return set(key, &value, sizeof(T));
+  }
+
+  /**
+   * @brief Read a fixed-size value; @p value is left unchanged unless a
+   * value of exactly sizeof(T) bytes is stored under the key.
+   */
+  template <typename T>
+  bool get(ConfigKey key, T& value) {
+    uint8_t tmp[sizeof(T)];
+    if (get(key, tmp, sizeof(T)) != static_cast<int>(sizeof(T))) {
+      return false;
+    }
+    memcpy(&value, tmp, sizeof(T));
+    return true;
+  }
+
+  /// Whether a value is stored under the key.
+  bool contains(ConfigKey key) const { return _ready && find(key.hash) >= 0; }
+
+  /// Stored length of a value, or -1 if missing.
+  int length(ConfigKey key) const {
+    const int slot = _ready ? find(key.hash) : -1;
+    return slot < 0 ? -1 : recordLength(_index[slot].offset);
+  }
+
+  /**
+   * @brief Delete a value. Its space is reclaimed by compact().
+   *
+   * @return true If the key existed and was deleted.
+   */
+  bool remove(ConfigKey key) {
+    const int slot = _ready ? find(key.hash) : -1;
+    if (slot < 0) return false;
+    const uint16_t offset = _index[slot].offset;
+    if (!markDeleted(offset)) return false;
+    _liveBytes -= ConfigRecord::storedSize(recordLength(offset));
+    erase(static_cast<uint16_t>(slot));
+    return true;
+  }
+
+  /**
+   * @brief Slide live records to the front and drop deleted ones.
+   *
+   * Called automatically by set() when the region is full.
+   *
+   * @return true If the region was compacted.
+   */
+  bool compact() {
+    if (!_ready) return false;
+    uint16_t read = 0;
+    uint16_t write = 0;
+    while (read < _end) {
+      RecordHeader header;
+      if (!_storage.read(_base + read, &header, ConfigRecord::HeaderSize)) {
+        return false;
+      }
+      const uint16_t stored = ConfigRecord::storedSize(header.length);
+      // Only the record the index points to is live; this also drops
+      // duplicates left by an interrupted set().
+      const int slot = find(header.type);
+      if ((header.flags & LiveFlag) && slot >= 0 &&
+          _index[slot].offset == read) {
+        if (write != read) {
+          if (!move(write, read, stored)) return false;
+          _index[slot].offset = write;
+        }
+        write = static_cast<uint16_t>(write + stored);
+      }
+      read = static_cast<uint16_t>(read + stored);
+    }
+    // Erase the whole tail, not just the next header: the old copies of
+    // moved records are intact past write, and once later appends cover
+    // a single erased header, the next begin() would find them again.
+    if (write < _end && !_storage.clear(_base + write, _end - write)) {
+      return false;
+    }
+    _end = write;
+    return true;
+  }
+
+  /**
+   * @brief Delete every value and erase the whole region.
+   *
+   * Erasing only the first header is not enough: once a later set()
+   * covers it, the next begin() would find the old records behind it.
+   */
+  bool format() {
+    clearIndex();
+    _end = 0;
+    _ready = _storage.clear(_base, _size);
+    return _ready;
+  }
+
+  /// Number of live keys.
+  uint16_t count() const { return _count; }
+
+  /// Maximum number of live keys.
+  static constexpr uint16_t capacity() { return MaxKeys; }
+
+  /// Bytes in use, including deleted records not yet compacted.
+  uint16_t usedBytes() const { return _end; }
+
+  /// Bytes taken by live records.
+  uint16_t liveBytes() const { return _liveBytes; }
+
+  /// Size of the region.
+  uint16_t size() const { return _size; }
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
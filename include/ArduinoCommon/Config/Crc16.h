@@ -0,0 +1,40 @@
+#ifndef ARDUINOCOMMON_CONFIG_CRC16_H
+#define ARDUINOCOMMON_CONFIG_CRC16_H
+
+#include <Arduino.h>
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief Table-driven CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+ *
+ * One table lookup per byte; the 512-byte table lives in flash
+ * (PROGMEM) on AVR. Data can be fed in pieces:
+ * @code
+ * uint16_t crc = Crc16::Init;
+ * crc = Crc16::update(crc, &header, sizeof(header));
+ * crc = Crc16::update(crc, payload, length);
+ * @endcode
+ */
+class Crc16 {
+ public:
+  static constexpr uint16_t Init = 0xFFFF;
+
+  /**
+   * @brief Continue a CRC over more bytes.
+   */
+  static uint16_t update(uint16_t crc, const void* data, size_t len);
+
+  /**
+   * @brief CRC of a single buffer.
+   */
+  static uint16_t compute(const void* data, size_t len) {
+    return update(Init, data, len);
+  }
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
@@ -3,8 +3,38 @@
 
 #include <Arduino.h>
 #include <EEPROM.h>
+#include <string.h>
 #include "IConfigStorage.h"
 
+// Cores whose EEPROM is a RAM buffer written back by EEPROM.commit().
+#ifndef ARDUINOCOMMON_EEPROM_NEEDS_COMMIT
+#if defined(ESP32) || defined(ARDUINO_ARCH_ESP32) || \
+    defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_SAMD)
+#define ARDUINOCOMMON_EEPROM_NEEDS_COMMIT 1
+#else
+#define ARDUINOCOMMON_EEPROM_NEEDS_COMMIT 0
+#endif
+#endif
+
+// Cores that expose that buffer through EEPROM.getDataPtr() and
+// EEPROM.getConstDataPtr(). getDataPtr() marks the whole buffer dirty,
+// so it is only used once a write is known to change something.
+#ifndef ARDUINOCOMMON_EEPROM_HAS_DATA_PTR
+#if defined(ESP32) || defined(ARDUINO_ARCH_ESP32) || \
+    defined(ARDUINO_ARCH_ESP8266)
+#define ARDUINOCOMMON_EEPROM_HAS_DATA_PTR 1
+#else
+#define ARDUINOCOMMON_EEPROM_HAS_DATA_PTR 0
+#endif
+#endif
+
+#if !ARDUINOCOMMON_EEPROM_HAS_DATA_PTR && defined(__AVR__)
+#include <avr/eeprom.h>
+#define ARDUINOCOMMON_EEPROM_HAS_AVR_BLOCK 1
+#else
+#define ARDUINOCOMMON_EEPROM_HAS_AVR_BLOCK 0
+#endif
+
 namespace ArduinoCommon {
 namespace Config {
 
@@ -16,18 +46,64 @@ namespace Config {
  * start of the region.
  *
  * This class does not perform wear-leveling; callers are responsible
- * for minimizing write cycles to a given region.
+ * for minimizing write cycles to a given region, e.g. by wrapping it in
+ * a WearLeveledStorage.
  */
 class EepromStorage : public IConfigStorage {
  private:
   size_t _size = 0;
 
+  /// Chunk size for block transfers through a stack buffer.
+  static constexpr size_t ChunkSize = 32;
+
+  bool inRange(uint16_t key, size_t len) const {
+    return static_cast<size_t>(key) + len <= _size;
+  }
+
+  /// True if every byte in [data, data + len) is 0xFF, compared a word
+  /// at a time.
+  static bool allErased(const uint8_t* data, size_t len) {
+    size_t i = 0;
+    for (; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t)) {
+      uint32_t word;
+      memcpy(&word, data + i, sizeof(word));
+      if (word != 0xFFFFFFFFUL) return false;
+    }
+    for (; i < len; ++i) {
+      if (data[i] != 0xFF) return false;
+    }
+    return true;
+  }
+
+  /// Copy len bytes to EEPROM, skipping unchanged bytes.
+  /// @return true If at least one byte changed.
+  static bool store(uint16_t key, const uint8_t* bytes, size_t len) {
+#if ARDUINOCOMMON_EEPROM_HAS_DATA_PTR
+    const uint8_t* current = EEPROM.getConstDataPtr() + key;
+    if (memcmp(current, bytes, len) == 0) return false;
+    memcpy(EEPROM.getDataPtr() + key, bytes, len);
+    return true;
+#elif ARDUINOCOMMON_EEPROM_HAS_AVR_BLOCK
+    eeprom_update_block(bytes, reinterpret_cast<void*>(key), len);
+    return true;
+#else
+    bool changed = false;
+    for (size_t i = 0; i < len; ++i) {
+      if (EEPROM.read(key + i) != bytes[i]) {
+        EEPROM.write(key + i, bytes[i]);
+        changed = true;
+      }
+    }
+    return changed;
+#endif
+  }
+
  public:
   /**
    * @brief Construct a new EepromStorage object for a given region size.
    *
-   * On ESP32 / SAMD platforms this will call EEPROM.begin(size) to
-   * initialize the emulated EEPROM. On AVR boards (e.g. Uno) this
+   * On ESP32 / ESP8266 / SAMD platforms this will call EEPROM.begin(size)
+   * to initialize the emulated EEPROM. On AVR boards (e.g. Uno) this
    * call is not required and is skipped.
    *
    * @param size Number of bytes in the EEPROM region reserved for
@@ -36,7 +112,7 @@ class EepromStorage : public IConfigStorage {
    */
 
   explicit EepromStorage(size_t size) {
-#if defined(ESP32) || defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_SAMD)
+#if ARDUINOCOMMON_EEPROM_NEEDS_COMMIT
     EEPROM.begin(size);
 #endif
     _size = size;
@@ -45,6 +121,9 @@ class EepromStorage : public IConfigStorage {
   /**
    * @brief Read a block of bytes from EEPROM.
    *
+   * Where the core exposes the emulated EEPROM buffer this is a single
+   * memcpy; on AVR it uses eeprom_read_block().
+   *
    * @param key  Byte offset into the reserved EEPROM region where
    *             the block begins (0-based).
    * @param data Pointer to a buffer where the data will be stored.
@@ -57,17 +136,25 @@ class EepromStorage : public IConfigStorage {
    *       it returns raw bytes as stored in EEPROM.
    */
   bool read(uint16_t key, void* data, size_t len) override {
-    if (key + len > _size) return false;
+    if (!inRange(key, len)) return false;
+#if ARDUINOCOMMON_EEPROM_HAS_DATA_PTR
+    memcpy(data, EEPROM.getConstDataPtr() + key, len);
+#elif ARDUINOCOMMON_EEPROM_HAS_AVR_BLOCK
+    eeprom_read_block(data, reinterpret_cast<const void*>(key), len);
+#else
     uint8_t* bytes = static_cast<uint8_t*>(data);
     for (size_t i = 0; i < len; ++i) {
       bytes[i] = EEPROM.read(key + i);
     }
+#endif
     return true;
   }
 
   /**
    * @brief Write a block of bytes to EEPROM.
    *
+   * Only bytes that differ from the stored data are written.
+   *
    * @param key  Byte offset into the reserved EEPROM region where
    *             the block will be written (0-based).
    * @param data Pointer to the buffer containing the bytes to write.
@@ -76,17 +163,18 @@ class EepromStorage : public IConfigStorage {
    *               all bytes were written.
    * @return false If the requested range exceeds the configured size.
    *
-   * @note On ESP32 / SAMD platforms this function calls EEPROM.commit()
-   *       after the write to persist changes to flash.
+   * @note On ESP32 / ESP8266 / SAMD platforms this function calls
+   *       EEPROM.commit() after the write to persist changes to flash,
+   *       unless no byte changed. Wrap the storage in a CachedStorage to
+   *       batch several writes into one commit.
    */
   bool write(uint16_t key, const void* data, size_t len) override {
-    if (key + len > _size) return false;
-    const uint8_t* bytes = static_cast<const uint8_t*>(data);
-    for (size_t i = 0; i < len; ++i) {
-      EEPROM.update(key + i, bytes[i]);
-    }
-#if defined(ESP32) || defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_SAMD)
-    EEPROM.commit();
+    if (!inRange(key, len)) return false;
+    const bool changed = store(key, static_cast<const uint8_t*>(data), len);
+#if ARDUINOCOMMON_EEPROM_NEEDS_COMMIT
+    if (changed) EEPROM.commit();
+#else
+    (void)changed;
 #endif
     return true;
   }
@@ -97,23 +185,31 @@ class EepromStorage : public IConfigStorage {
    * This function scans len bytes starting at the given key offset.
    * If any byte is not equal to 0xFF, the region is considered "used".
    * This relies on the convention that erased EEPROM bytes are 0xFF.
+   * Bytes are compared a 32-bit word at a time.
    *
    * @param key Byte offset into the reserved EEPROM region.
    * @param len Number of bytes to inspect.
    * @return true  If at least one byte in the range is not 0xFF.
-   * @return false If all bytes in the range are 0xFF.
+   * @return false If all bytes in the range are 0xFF, or the range
+   *               exceeds the configured size.
    *
    * @warning This is a heuristic: it cannot distinguish between a
    *          truly unused region and a region that was intentionally
    *          written with all 0xFF bytes.
    */
   virtual bool isUsed(uint16_t key, size_t len) {
-    for (size_t i = 0; i < len; i++) {
-      if (EEPROM.read(key + i) != 0xFF) {
-        return true;
-      }
+    if (!inRange(key, len)) return false;
+#if ARDUINOCOMMON_EEPROM_HAS_DATA_PTR
+    return !allErased(EEPROM.getConstDataPtr() + key, len);
+#else
+    uint8_t chunk[ChunkSize];
+    for (size_t done = 0; done < len; done += ChunkSize) {
+      const size_t n = len - done < ChunkSize ? len - done : ChunkSize;
+      read(static_cast<uint16_t>(key + done), chunk, n);
+      if (!allErased(chunk, n)) return true;
     }
     return false;
+#endif
   }
 
   /**
@@ -122,24 +218,36 @@ class EepromStorage : public IConfigStorage {
    * @param key Byte offset into the reserved EEPROM region where
    *            the clear range begins.
    * @param len Number of bytes to clear.
-   * @return true Always returns true if the requested range is within
-   *              the configured region.
+   * @return true  If the requested range is within the configured region.
+   * @return false If the range exceeds the configured size.
    *
-   * @note On ESP32 / SAMD platforms this function calls EEPROM.commit()
-   *       after writing.
+   * @note On ESP32 / ESP8266 / SAMD platforms this function calls
+   *       EEPROM.commit() after writing, unless the range was already
+   *       clear.
    */
 
   virtual bool clear(uint16_t key, size_t len) {
-    for (size_t i = 0; i < len; ++i) {
-      EEPROM.update(key + i, 0xFF);
+    if (!inRange(key, len)) return false;
+    uint8_t erased[ChunkSize];
+    memset(erased, 0xFF, sizeof(erased));
+
+    bool changed = false;
+    for (size_t done = 0; done < len; done += ChunkSize) {
+      const size_t n = len - done < ChunkSize ? len - done : ChunkSize;
+      changed |= store(static_cast<uint16_t>(key + done), erased, n);
     }
-#if defined(ESP32) || defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_SAMD)
-    EEPROM.commit();
+#if ARDUINOCOMMON_EEPROM_NEEDS_COMMIT
+    if (changed) EEPROM.commit();
+#else
+    (void)changed;
 #endif
     return true;
   }
+
+  /// Size of the reserved region in bytes.
+  size_t size() const { return _size; }
 };
 }  // namespace Config
 }  // namespace ArduinoCommon
 
-#endif
\ No newline at end of file
+#endif
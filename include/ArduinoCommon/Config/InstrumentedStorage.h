@@ -0,0 +1,159 @@
+#ifndef ARDUINOCOMMON_CONFIG_INSTRUMENTEDSTORAGE_H
+#define ARDUINOCOMMON_CONFIG_INSTRUMENTEDSTORAGE_H
+
+#include <Arduino.h>
+#include "IConfigStorage.h"
+
+#ifndef ARDUINOCOMMON_INSTRUMENTED_MAX_REGIONS
+/// Named regions an InstrumentedStorage can track.
+#define ARDUINOCOMMON_INSTRUMENTED_MAX_REGIONS 8
+#endif
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief Call latency histogram with power-of-two buckets.
+ *
+ * Bucket 0 counts calls under 16 us, bucket i calls under 16 << i us,
+ * and the last bucket everything slower.
+ */
+struct LatencyHistogram {
+  static constexpr uint8_t Buckets = 12;
+
+  uint32_t counts[Buckets] = {};
+  uint32_t calls = 0;
+  uint32_t totalMicros = 0;
+  uint32_t maxMicros = 0;
+
+  /// Upper bound (exclusive) of a bucket in microseconds; 0 for the last.
+  static uint32_t bucketLimit(uint8_t bucket) {
+    return bucket + 1 < Buckets ? 16UL << bucket : 0;
+  }
+
+  void record(uint32_t micros);
+  void reset();
+};
+
+/**
+ * @brief Traffic counters for one region of an InstrumentedStorage.
+ */
+struct StorageRegionStats {
+  const char* name = nullptr;
+  uint16_t begin = 0;
+  uint16_t length = 0;
+
+  uint32_t reads = 0;         ///< read() and isUsed() calls.
+  uint32_t bytesRead = 0;
+  uint32_t writes = 0;        ///< write() calls.
+  uint32_t clears = 0;        ///< clear() calls.
+  uint32_t bytesWritten = 0;  ///< Bytes passed to write() and clear().
+  uint32_t bytesChanged = 0;  ///< Of those, bytes that differed.
+  uint32_t noOps = 0;         ///< Writes and clears that changed nothing.
+  uint32_t commits = 0;       ///< Writes and clears that changed something.
+  uint32_t failures = 0;      ///< Calls the backing storage rejected.
+
+  void reset();
+};
+
+/**
+ * @brief Decorator that measures the traffic going to an IConfigStorage.
+ *
+ * Forwards every call unchanged and records, per region:
+ *  - reads, writes and clears, with the bytes they cover;
+ *  - how many written bytes actually differed from the stored ones,
+ *    which separates real commits from no-op updates (the backing
+ *    contents are read before each write to find out);
+ * plus one latency histogram per operation type, timed with micros().
+ *
+ * Regions are declared with addRegion(); accesses that fall in no
+ * region are counted in other(). An access is attributed to the region
+ * containing its first byte.
+ *
+ * Typical usage:
+ * @code
+ * EepromStorage eeprom(512);
+ * InstrumentedStorage stats(eeprom);
+ *
+ * void setup() {
+ *   stats.addRegion("soilA", Layout::offset<0>(), Layout::sizeOf<0>());
+ *   stats.addRegion("soilB", Layout::offset<1>(), Layout::sizeOf<1>());
+ *   soilA.attachStorage(&stats, Layout::offset<0>());
+ *   soilB.attachStorage(&stats, Layout::offset<1>());
+ * }
+ *
+ * // Later, e.g. on a serial command:
+ * stats.dumpStats(Serial);
+ * @endcode
+ *
+ * Commits per hour of a region, times the bytes each one changes, gives
+ * the cell wear rate to compare against the memory's endurance.
+ */
+class InstrumentedStorage : public IConfigStorage {
+ public:
+  static constexpr uint8_t MaxRegions = ARDUINOCOMMON_INSTRUMENTED_MAX_REGIONS;
+
+  explicit InstrumentedStorage(IConfigStorage& backing);
+
+  /**
+   * @brief Track [begin, begin + length) under @p name.
+   *
+   * @param name Label printed by dumpStats(); must outlive this object.
+   * @return false If all MaxRegions slots are taken.
+   */
+  bool addRegion(const char* name, uint16_t begin, uint16_t length);
+
+  bool read(uint16_t key, void* data, size_t len) override;
+  bool write(uint16_t key, const void* data, size_t len) override;
+  bool isUsed(uint16_t key, size_t len) override;
+  bool clear(uint16_t key, size_t len) override;
+
+  /// Number of regions added.
+  uint8_t regionCount() const { return _regionCount; }
+
+  /// Counters of region @p index (in addRegion() order).
+  const StorageRegionStats& region(uint8_t index) const {
+    return index < _regionCount ? _regions[index] : _other;
+  }
+
+  /// Counters of accesses outside every region.
+  const StorageRegionStats& other() const { return _other; }
+
+  const LatencyHistogram& readLatency() const { return _readLatency; }
+  const LatencyHistogram& writeLatency() const { return _writeLatency; }
+  const LatencyHistogram& clearLatency() const { return _clearLatency; }
+
+  /// Clear all counters and restart the measurement period.
+  void resetStats();
+
+  /**
+   * @brief Print per-region counters and latency histograms.
+   *
+   * @param out The output stream or data log (default is Serial).
+   */
+  void dumpStats(Stream& out = Serial) const;
+
+ private:
+  IConfigStorage& _backing;
+  StorageRegionStats _regions[MaxRegions];
+  StorageRegionStats _other;
+  uint8_t _regionCount = 0;
+  LatencyHistogram _readLatency;
+  LatencyHistogram _writeLatency;
+  LatencyHistogram _clearLatency;
+  uint32_t _sinceMs = 0;
+
+  StorageRegionStats& regionFor(uint16_t key);
+
+  /// Count bytes in [key, key + len) that differ from data (or 0xFF).
+  uint32_t countChanges(uint16_t key, const uint8_t* data, size_t len);
+
+  /// Update counters after a write() or clear().
+  void recordWrite(StorageRegionStats& region, size_t len, uint32_t changed,
+                   bool ok);
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef ARDUINOCOMMON_CONFIG_MMAPFILESTORAGE_H
+#define ARDUINOCOMMON_CONFIG_MMAPFILESTORAGE_H
+
+#include <Arduino.h>
+#include "SimulatedStorage.h"
+
+/**
+ * @brief Whether MmapFileStorage is available (POSIX hosts only).
+ *
+ * Board toolchains do not have <sys/mman.h>; there the class is not
+ * declared at all.
+ */
+#ifndef ARDUINOCOMMON_HAS_MMAP
+#if (defined(__unix__) || defined(__APPLE__)) && defined(__has_include)
+#if __has_include(<sys/mman.h>)
+#define ARDUINOCOMMON_HAS_MMAP 1
+#endif
+#endif
+#endif
+
+#ifndef ARDUINOCOMMON_HAS_MMAP
+#define ARDUINOCOMMON_HAS_MMAP 0
+#endif
+
+#if ARDUINOCOMMON_HAS_MMAP
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief File-backed storage for host builds, mapped with mmap().
+ *
+ * Contents persist in the file across runs, so a host program can be
+ * stopped (or killed, to model a power cut) and restarted against the
+ * same "EEPROM". A new or short file is extended with erased bytes
+ * (0xFF). Latency, erase granularity and per-cell wear are simulated as
+ * in SimulatedStorage; the wear counters live in RAM and start at zero
+ * on every open().
+ *
+ * @code
+ * MmapFileStorage storage;
+ * if (!storage.open("eeprom.bin", 1024)) return 1;
+ * ConfigStore<16> store(storage, 0, 1024);
+ * @endcode
+ */
+class MmapFileStorage : public SimulatedStorage {
+ public:
+  explicit MmapFileStorage(
+      const StorageSimulation& simulation = StorageSimulation());
+  ~MmapFileStorage();
+
+  MmapFileStorage(const MmapFileStorage&) = delete;
+  MmapFileStorage& operator=(const MmapFileStorage&) = delete;
+
+  /**
+   * @brief Map @p size bytes of @p path, creating the file if needed.
+   *
+   * @return false If the file cannot be opened, sized or mapped.
+   */
+  bool open(const char* path, size_t size);
+
+  /// Flush the mapping to the file.
+  bool sync();
+
+  /// Sync and unmap; the storage then rejects every access.
+  void close();
+
+  bool isOpen() const { return _map != nullptr; }
+
+ private:
+  int _fd = -1;
+  uint8_t* _map = nullptr;
+  uint32_t* _wear = nullptr;
+  size_t _mapSize = 0;
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif  // ARDUINOCOMMON_HAS_MMAP
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef ARDUINOCOMMON_CONFIG_RAMSTORAGE_H
+#define ARDUINOCOMMON_CONFIG_RAMSTORAGE_H
+
+#include <Arduino.h>
+#include <string.h>
+#include "SimulatedStorage.h"
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief RAM-backed storage with simulated latency and wear.
+ *
+ * Starts out erased (all 0xFF). Needs 5 bytes of RAM per storage byte
+ * (data plus a 32-bit wear counter), so it is meant for host builds and
+ * tests rather than small boards.
+ *
+ * @code
+ * StorageSimulation flash;
+ * flash.eraseBlockSize = 256;
+ * flash.writeLatencyUs = 10;
+ * flash.eraseLatencyUs = 4000;
+ * RamStorage<1024> storage(flash);
+ * WearLeveledStorage<32> config(storage, 0, 1024);
+ * ...
+ * Serial.println(storage.maxCellWrites());
+ * @endcode
+ *
+ * @tparam Size Storage size in bytes.
+ */
+template <size_t Size>
+class RamStorage : public SimulatedStorage {
+  static_assert(Size > 0, "RamStorage: Size must be > 0.");
+
+ private:
+  uint8_t _data[Size];
+  uint32_t _wear[Size];
+
+ public:
+  explicit RamStorage(const StorageSimulation& simulation = StorageSimulation())
+      : SimulatedStorage(simulation) {
+    memset(_data, 0xFF, sizeof(_data));
+    memset(_wear, 0, sizeof(_wear));
+    attach(_data, _wear, Size);
+  }
+
+  RamStorage(const RamStorage&) = delete;
+  RamStorage& operator=(const RamStorage&) = delete;
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
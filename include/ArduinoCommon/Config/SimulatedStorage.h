@@ -0,0 +1,116 @@
+#ifndef ARDUINOCOMMON_CONFIG_SIMULATEDSTORAGE_H
+#define ARDUINOCOMMON_CONFIG_SIMULATEDSTORAGE_H
+
+#include <Arduino.h>
+#include "IConfigStorage.h"
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief Device characteristics simulated by a SimulatedStorage.
+ */
+struct StorageSimulation {
+  /// Bytes per erase unit. 1 models byte-writable EEPROM; larger values
+  /// model flash, where setting any bit back to 1 erases the whole block.
+  uint16_t eraseBlockSize = 1;
+  uint32_t writeLatencyUs = 0;  ///< Per programmed byte.
+  uint32_t eraseLatencyUs = 0;  ///< Per erased block.
+  /// Skip bytes that already hold the value (EEPROM.update() semantics).
+  bool skipUnchanged = true;
+  /// Actually block for the simulated latency with delayMicroseconds().
+  bool realDelay = false;
+};
+
+/**
+ * @brief IConfigStorage over a plain byte buffer that models the cost and
+ * wear of a non-volatile memory.
+ *
+ * Every programmed byte and every erased block is counted per cell, and
+ * the latency the real device would need is accumulated in
+ * simulatedMicros() (or spent, with StorageSimulation::realDelay). This
+ * lets storage strategies (wear leveling, caching, A/B commits) be
+ * compared for throughput and wear without flashing a board.
+ *
+ * Subclasses provide the buffer: RamStorage (fixed array) and
+ * MmapFileStorage (file mapped with mmap on POSIX hosts).
+ */
+class SimulatedStorage : public IConfigStorage {
+ public:
+  bool read(uint16_t key, void* data, size_t len) override;
+  bool write(uint16_t key, const void* data, size_t len) override;
+  bool isUsed(uint16_t key, size_t len) override;
+  bool clear(uint16_t key, size_t len) override;
+
+  /// Size of the storage in bytes.
+  size_t size() const { return _size; }
+
+  /// Raw contents, for inspection.
+  const uint8_t* data() const { return _bytes; }
+
+  /// Wear of one cell: programs plus erases of its block.
+  uint32_t cellWrites(size_t index) const {
+    return index < _size ? _cellWrites[index] : 0;
+  }
+
+  /// Highest cellWrites() within [key, key + len).
+  uint32_t maxCellWrites(size_t key, size_t len) const;
+
+  /// Highest cellWrites() over the whole storage.
+  uint32_t maxCellWrites() const { return maxCellWrites(0, _size); }
+
+  uint32_t readCalls() const { return _readCalls; }
+  uint32_t writeCalls() const { return _writeCalls; }
+  uint32_t bytesRead() const { return _bytesRead; }
+  /// Bytes actually programmed.
+  uint32_t bytesProgrammed() const { return _bytesProgrammed; }
+  /// Bytes skipped because they already held the value.
+  uint32_t bytesSkipped() const { return _bytesSkipped; }
+  /// Erase blocks erased.
+  uint32_t blockErases() const { return _blockErases; }
+  /// Latency the real device would have spent, in microseconds.
+  uint32_t simulatedMicros() const { return _simulatedMicros; }
+
+  /// Reset all counters (contents are kept).
+  void resetStats();
+
+  const StorageSimulation& simulation() const { return _simulation; }
+  void setSimulation(const StorageSimulation& simulation) {
+    _simulation = simulation;
+    if (_simulation.eraseBlockSize == 0) _simulation.eraseBlockSize = 1;
+  }
+
+ protected:
+  SimulatedStorage(const StorageSimulation& simulation);
+
+  /// Point at the buffers; called by subclasses once they exist.
+  void attach(uint8_t* bytes, uint32_t* cellWrites, size_t size);
+
+ private:
+  uint8_t* _bytes = nullptr;
+  uint32_t* _cellWrites = nullptr;
+  size_t _size = 0;
+  StorageSimulation _simulation;
+
+  uint32_t _readCalls = 0;
+  uint32_t _writeCalls = 0;
+  uint32_t _bytesRead = 0;
+  uint32_t _bytesProgrammed = 0;
+  uint32_t _bytesSkipped = 0;
+  uint32_t _blockErases = 0;
+  uint32_t _simulatedMicros = 0;
+
+  bool inRange(uint16_t key, size_t len) const {
+    return _bytes && static_cast<size_t>(key) + len <= _size;
+  }
+
+  void spend(uint32_t micros);
+
+  /// Store [key, key + len) from data (or 0xFF if data is null).
+  void store(size_t key, const uint8_t* data, size_t len);
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,322 @@
+#ifndef ARDUINOCOMMON_CONFIG_WEARLEVELEDSTORAGE_H
+#define ARDUINOCOMMON_CONFIG_WEARLEVELEDSTORAGE_H
+
+#include <Arduino.h>
+#include <string.h>
+#include "Crc16.h"
+#include "IConfigStorage.h"
+
+namespace ArduinoCommon {
+namespace Config {
+
+/**
+ * @brief Header stored in front of every WearLeveledStorage record.
+ */
+struct WearRecordHeader {
+  uint32_t sequence;  ///< Increments by one per record.
+  uint16_t key;       ///< Logical offset of the payload.
+  uint16_t length;    ///< Payload length in bytes.
+  uint8_t magic;      ///< WearRecordHeader::Magic for a written record.
+  uint8_t reserved;   ///< 0xFF; spells out what would be padding.
+  uint16_t crc;       ///< CRC-16 of the other header fields and payload.
+
+  static constexpr uint8_t Magic = 0xA5;
+};
+
+/**
+ * @brief Log-structured, wear-leveling adapter for any IConfigStorage.
+ *
+ * Presents a small logical storage of @p LogicalSize bytes on top of a
+ * larger reserved region of another storage. Instead of rewriting the
+ * same bytes in place, every write() appends a record (header + changed
+ * bytes) to a log, so repeated updates of one value (auto-calibration,
+ * counters) are spread over the whole region.
+ *
+ * The region is split into two halves. Each half starts with a snapshot
+ * record holding the complete logical image, followed by patch records.
+ * When the active half is full, the log is compacted: a fresh snapshot is
+ * written to the start of the other half, which then becomes active. The
+ * old half stays intact until the new snapshot is complete, so a power
+ * loss during compaction falls back to the previous state.
+ *
+ * At begin() the two snapshot headers decide which half is newer (two
+ * header reads), then the patches in that half are replayed into a RAM
+ * copy of the image. Reads are served from RAM; writes that do not change
+ * any byte are skipped without touching the backing storage.
+ *
+ * Typical usage:
+ * @code
+ * EepromStorage eeprom(512);
+ * WearLeveledStorage<32> config(eeprom, 0, 512);  // 32 bytes, 512 of wear
+ *
+ * void setup() {
+ *   config.begin();
+ *   soil.attachStorage(&config, 0);
+ * }
+ * @endcode
+ *
+ * Each record costs sizeof(WearRecordHeader) bytes of overhead, and a
+ * half must hold at least two snapshots. Records are protected by a
+ * CRC-16 (see Crc16), so a torn record is replayed only about once in
+ * 65536 failures rather than once in 256 with an 8-bit checksum.
+ *
+ * @tparam LogicalSize Size of the logical storage in bytes.
+ */
+template <uint16_t LogicalSize>
+class WearLeveledStorage : public IConfigStorage {
+  static_assert(LogicalSize > 0, "WearLeveledStorage: LogicalSize must be > 0.");
+
+ public:
+  static constexpr uint16_t HeaderSize = sizeof(WearRecordHeader);
+  static constexpr uint16_t SnapshotSize = HeaderSize + LogicalSize;
+
+ private:
+  IConfigStorage& _backing;
+  uint16_t _base;
+  uint16_t _halfSize;
+  uint8_t _image[LogicalSize];
+
+  uint8_t _activeHalf = 0;
+  uint16_t _writeOffset = 0;  ///< Next free byte in the active half.
+  uint32_t _sequence = 0;     ///< Sequence of the last record.
+  uint32_t _compactions = 0;
+  bool _hasLog = false;
+  bool _ready = false;
+
+  /// CRC of the header fields other than crc, in the order and byte
+  /// order they are laid out on little-endian targets.
+  static uint16_t headerCrc(const WearRecordHeader& header) {
+    const uint8_t fields[] = {
+        static_cast<uint8_t>(header.sequence),
+        static_cast<uint8_t>(header.sequence >> 8),
+        static_cast<uint8_t>(header.sequence >> 16),
+        static_cast<uint8_t>(header.sequence >> 24),
+        static_cast<uint8_t>(header.key),
+        static_cast<uint8_t>(header.key >> 8),
+        static_cast<uint8_t>(header.length),
+        static_cast<uint8_t>(header.length >> 8),
+        header.magic,
+        header.reserved,
+    };
+    return Crc16::compute(fields, sizeof(fields));
+  }
+
+  uint16_t halfStart(uint8_t half) const {
+    return static_cast<uint16_t>(_base + half * _halfSize);
+  }
+
+  /// Read a header and verify it (and its payload) against the backing
+  /// storage without modifying the image.
+  bool readRecord(uint16_t address, WearRecordHeader& header) {
+    if (!_backing.read(address, &header, HeaderSize)) return false;
+    if (header.magic != WearRecordHeader::Magic) return false;
+    if (header.length == 0 || header.key + header.length > LogicalSize) {
+      return false;
+    }
+
+    uint16_t crc = headerCrc(header);
+    uint8_t chunk[16];
+    uint16_t done = 0;
+    while (done < header.length) {
+      uint16_t n = static_cast<uint16_t>(header.length - done);
+      if (n > sizeof(chunk)) n = sizeof(chunk);
+      if (!_backing.read(address + HeaderSize + done, chunk, n)) return false;
+      crc = Crc16::update(crc, chunk, n);
+      done = static_cast<uint16_t>(done + n);
+    }
+    return crc == header.crc;
+  }
+
+  /// Append image[key, key + len) as a record at address.
+  bool writeRecord(uint16_t address, uint16_t key, uint16_t len) {
+    WearRecordHeader header{};
+    header.sequence = _sequence + 1;
+    header.key = key;
+    header.length = len;
+    header.magic = WearRecordHeader::Magic;
+    header.reserved = 0xFF;
+    header.crc = Crc16::update(headerCrc(header), _image + key, len);
+
+    // Payload first: a header is only valid once its payload is in place.
+    if (!_backing.write(address + HeaderSize, _image + key, len)) return false;
+    if (!_backing.write(address, &header, HeaderSize)) return false;
+    _sequence = header.sequence;
+    return true;
+  }
+
+  bool compact() {
+    const uint8_t target = _hasLog ? static_cast<uint8_t>(1 - _activeHalf)
+                                   : _activeHalf;
+    if (!writeRecord(halfStart(target), 0, LogicalSize)) return false;
+    _activeHalf = target;
+    _writeOffset = SnapshotSize;
+    if (_hasLog) ++_compactions;
+    _hasLog = true;
+    return true;
+  }
+
+  bool append(uint16_t key, uint16_t len) {
+    const uint32_t end = static_cast<uint32_t>(_writeOffset) + HeaderSize + len;
+    if (!_hasLog || end > _halfSize) {
+      return compact();
+    }
+    if (!writeRecord(halfStart(_activeHalf) + _writeOffset, key, len)) {
+      return false;
+    }
+    _writeOffset = static_cast<uint16_t>(_writeOffset + HeaderSize + len);
+    return true;
+  }
+
+  bool isSnapshot(const WearRecordHeader& header) const {
+    return header.key == 0 && header.length == LogicalSize;
+  }
+
+ public:
+  /**
+   * @brief Wrap a region of another storage.
+   *
+   * @param backing    Storage that holds the log.
+   * @param base       First byte of the reserved region in @p backing.
+   * @param regionSize Size of the reserved region; at least
+   *                   4 * SnapshotSize.
+   */
+  WearLeveledStorage(IConfigStorage& backing, uint16_t base,
+                     uint16_t regionSize)
+      : _backing(backing),
+        _base(base),
+        _halfSize(static_cast<uint16_t>(regionSize / 2)) {
+    memset(_image, 0xFF, sizeof(_image));
+  }
+
+  /**
+   * @brief Locate the newest snapshot and replay the log into RAM.
+   *
+   * @return true  If the region is large enough. A blank or unreadable
+   *               region starts out as an erased (all 0xFF) image.
+   * @return false If the region cannot hold two snapshots per half.
+   */
+  bool begin() {
+    _ready = false;
+    _hasLog = false;
+    _activeHalf = 0;
+    _writeOffset = 0;
+    _sequence = 0;
+    memset(_image, 0xFF, sizeof(_image));
+    if (_halfSize < 2 * SnapshotSize) return false;
+
+    WearRecordHeader newest = {};
+    for (uint8_t half = 0; half < 2; ++half) {
+      WearRecordHeader header{};
+      if (!readRecord(halfStart(half), header) || !isSnapshot(header)) {
+        continue;
+      }
+      if (!_hasLog ||
+          static_cast<int32_t>(header.sequence - newest.sequence) > 0) {
+        newest = header;
+        _activeHalf = half;
+        _hasLog = true;
+      }
+    }
+
+    if (_hasLog) {
+      const uint16_t start = halfStart(_activeHalf);
+      _backing.read(start + HeaderSize, _image, LogicalSize);
+      _sequence = newest.sequence;
+      _writeOffset = SnapshotSize;
+
+      // Replay patches until the sequence breaks (stale or torn record).
+      WearRecordHeader header{};
+      while (static_cast<uint32_t>(_writeOffset) + HeaderSize <= _halfSize &&
+             readRecord(start + _writeOffset, header) &&
+             header.sequence == _sequence + 1 &&
+             static_cast<uint32_t>(_writeOffset) + HeaderSize +
+                     header.length <= _halfSize) {
+        _backing.read(start + _writeOffset + HeaderSize, _image + header.key,
+                      header.length);
+        _sequence = header.sequence;
+        _writeOffset =
+            static_cast<uint16_t>(_writeOffset + HeaderSize + header.length);
+      }
+    }
+
+    _ready = true;
+    return true;
+  }
+
+  bool read(uint16_t key, void* data, size_t len) override {
+    if (!_ready || key + len > LogicalSize) return false;
+    memcpy(data, _image + key, len);
+    return true;
+  }
+
+  /**
+   * @brief Update bytes and append the change to the log.
+   *
+   * Only the span between the first and last changed byte is logged;
+   * a write that changes nothing does not touch the backing storage.
+   */
+  bool write(uint16_t key, const void* data, size_t len) override {
+    if (!_ready || key + len > LogicalSize) return false;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    size_t first = 0;
+    while (first < len && _image[key + first] == bytes[first]) ++first;
+    if (first == len) return true;
+    size_t last = len - 1;
+    while (_image[key + last] == bytes[last]) --last;
+
+    // Records are written from the image, so apply the change first and
+    // if it does not reach the backing storage, reload the image from the
+    // log: otherwise a retry would find nothing to write.
+    memcpy(_image + key + first, bytes + first, last - first + 1);
+    if (append(static_cast<uint16_t>(key + first),
+               static_cast<uint16_t>(last - first + 1))) {
+      return true;
+    }
+    begin();
+    return false;
+  }
+
+  bool isUsed(uint16_t key, size_t len) override {
+    if (!_ready || key + len > LogicalSize) return false;
+    for (size_t i = 0; i < len; ++i) {
+      if (_image[key + i] != 0xFF) return true;
+    }
+    return false;
+  }
+
+  bool clear(uint16_t key, size_t len) override {
+    if (!_ready || key + len > LogicalSize) return false;
+    uint8_t erased[16];
+    memset(erased, 0xFF, sizeof(erased));
+    // Clear in chunks; unchanged chunks are skipped by write().
+    size_t done = 0;
+    while (done < len) {
+      size_t n = len - done;
+      if (n > sizeof(erased)) n = sizeof(erased);
+      if (!write(static_cast<uint16_t>(key + done), erased, n)) return false;
+      done += n;
+    }
+    return true;
+  }
+
+  /// Logical size in bytes.
+  static constexpr uint16_t size() { return LogicalSize; }
+
+  /// Sequence number of the newest record (0 if the log is empty).
+  uint32_t sequence() const { return _sequence; }
+
+  /// Number of compactions since begin().
+  uint32_t compactions() const { return _compactions; }
+
+  /// Half of the region currently receiving records (0 or 1).
+  uint8_t activeHalf() const { return _activeHalf; }
+
+  /// Bytes used in the active half.
+  uint16_t logOffset() const { return _writeOffset; }
+};
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif
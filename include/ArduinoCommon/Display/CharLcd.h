@@ -0,0 +1,518 @@
+#ifndef ARDUINOCOMMON_DISPLAY_CHARLCD_H
+#define ARDUINOCOMMON_DISPLAY_CHARLCD_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "LcdField.h"
+#include "Pcf8574Lcd.h"
+
+#ifndef ARDUINOCOMMON_LCD_UPDATE_CHARS
+/// Characters CharLcd::update() sends per call by default.
+#define ARDUINOCOMMON_LCD_UPDATE_CHARS 4
+#endif
+
+namespace ArduinoCommon {
+namespace Display {
+
+/**
+ * @brief Geometry-independent part of CharLcd: I2C pins, the driver and
+ * the bus settings.
+ *
+ * Not used directly; see CharLcd.
+ */
+class CharLcdBase {
+ public:
+  static constexpr uint32_t StandardMode = 100000UL;  ///< 100 kHz I2C
+  static constexpr uint32_t FastMode = 400000UL;      ///< 400 kHz I2C
+  static constexpr uint32_t KeepClock = 0;  ///< Leave the bus clock alone
+
+  CharLcdBase(const CharLcdBase&) = delete;
+  CharLcdBase& operator=(const CharLcdBase&) = delete;
+
+  /**
+   * @brief Set the I2C clock.
+   *
+   * Applied by begin(), or immediately if already initialized. By
+   * default (KeepClock) the display never changes the clock, since it is
+   * shared by every device on the bus. Note that on some cores (AVR)
+   * Wire.begin(), which begin() calls, itself resets the clock to
+   * 100 kHz; pass the clock here to have it restored.
+   *
+   * FastMode cuts the bus time per character from ~360 us to ~90 us;
+   * only use it if every device on the bus supports 400 kHz.
+   *
+   * @param hz Clock frequency in Hz, or KeepClock
+   */
+  void setBusClock(uint32_t hz) noexcept;
+
+  /**
+   * @brief Check whether the LCD configuration is valid.
+   *
+   * This reflects successful pin reservation and object construction.
+   * It does not indicate whether begin() has succeeded.
+   *
+   * @return true if configuration is valid
+   * @return false otherwise
+   */
+  bool validConfiguration() const noexcept { return validConfig; }
+
+  /**
+   * @brief Choose whether printLine() and clear() flush immediately.
+   *
+   * @param enabled false to batch updates until flush() or update()
+   *                (default true)
+   */
+  void setAutoFlush(bool enabled) noexcept { autoFlush = enabled; }
+
+  /// @return true if printLine() and clear() flush immediately.
+  bool getAutoFlush() const noexcept { return autoFlush; }
+
+#ifdef ARDUINOCOMMON_TESTING
+  /**
+   * @brief Test-only access to the underlying LCD driver pointer.
+   * @warning Only available when ARDUINOCOMMON_TESTING is defined.
+   */
+  Pcf8574Lcd* _getLcdForTests() const noexcept { return lcd; }
+#endif
+
+ protected:
+  /**
+   * @brief Acquire the I2C pins and create the driver.
+   *
+   * The pins are shared through I2cBusManager, so several displays can
+   * be constructed on the same SDA/SCL pair and @p bus.
+   */
+  CharLcdBase(uint8_t sdaP, uint8_t sclP, uint8_t address, uint8_t numCols,
+              uint8_t numRows, LcdI2cBus& bus) noexcept;
+
+  /// Frees the driver and releases this display's use of the bus.
+  ~CharLcdBase();
+
+  /**
+   * @brief Start the bus, check the backpack answers and initialize it.
+   *
+   * @return true if the display is ready for output
+   */
+  bool beginDriver();
+
+  /// true once beginDriver() has succeeded.
+  bool ready() const noexcept { return validConfig && initialized; }
+
+  /// Queue a cursor move to a display RAM address.
+  void moveTo(uint8_t ddram);
+
+  /// Queue @p len characters at the cursor.
+  void send(const char* cells, uint8_t len);
+
+  /// Send everything queued.
+  void commit();
+
+  bool autoFlush;  ///< Flush after every printLine()/clear()
+
+ private:
+  Pcf8574Lcd* lcd;     ///< Pointer to underlying I2C LCD driver
+  uint8_t sdaPin;      ///< SDA pin used for I2C (shared via I2cBusManager)
+  uint8_t sclPin;      ///< SCL pin used for I2C (shared via I2cBusManager)
+  uint8_t i2cAddress;  ///< I2C address of the LCD backpack
+  bool validConfig;    ///< True if pins acquired and object initialized
+  bool initialized;    ///< True once begin() has succeeded
+  uint32_t busClock;   ///< I2C clock applied by begin(), or KeepClock
+};
+
+/**
+ * @brief Driver wrapper for an HD44780 character LCD with I2C backpack,
+ * for any of the common geometries.
+ *
+ * This class provides a safe, high-level interface for controlling a
+ * character LCD over I2C, through the in-tree Pcf8574Lcd driver. It
+ * integrates with PinManager (through I2cBusManager) to prevent pin
+ * conflicts and supports runtime validation of the I2C device.
+ *
+ * The size is a template parameter, so the framebuffers are exactly as
+ * large as the panel and the row offsets in display RAM are constants.
+ * LCD1602, LCD2004 and LCD4002 name the usual sizes.
+ *
+ * Key features:
+ *  - I2C pins shared between displays on the same bus
+ *  - Configurable I2C address
+ *  - I2C presence validation during begin()
+ *  - Safe row-based printing with automatic line clearing
+ *  - Shadow framebuffer: only cells that changed are sent to the panel
+ *
+ * Text is written into a framebuffer. flush() compares it with what the
+ * panel currently shows and sends only the changed runs of cells, moving
+ * the cursor only where a run does not continue from the previous one.
+ * Rewriting a line with mostly the same text (a clock, a sensor value)
+ * costs one cursor move plus the changed characters instead of a cursor
+ * move per row and a whole screen of characters.
+ *
+ * By default every printLine() and clear() flushes immediately. With
+ * setAutoFlush(false), several updates can be batched into one flush(),
+ * or sent a few characters at a time by update() so the display never
+ * blocks loop() for long:
+ * @code
+ * lcd.setAutoFlush(false);
+ *
+ * void loop() {
+ *   lcd.printLine(1, text);   // only edits the framebuffer
+ *   lcd.update();             // sends at most a few characters
+ *   ...
+ * }
+ * @endcode
+ *
+ * Several displays can share one bus at different addresses:
+ * @code
+ * LCD1602 status(A4, A5, 0x27);
+ * LCD2004 details(A4, A5, 0x3F);
+ * if (status.begin() && details.begin()) {
+ *   status.printLine(0, F("Hello"));
+ *   details.printLine(3, F("World"));
+ * }
+ * @endcode
+ *
+ * @tparam NumCols Characters per row (1 to 40)
+ * @tparam NumRows Number of rows (1 to 4)
+ */
+template <uint8_t NumCols, uint8_t NumRows>
+class CharLcd : public CharLcdBase {
+  static_assert(NumCols >= 1 && NumCols <= 40,
+                "CharLcd: 1 to 40 columns supported");
+  static_assert(NumRows >= 1 && NumRows <= 4,
+                "CharLcd: 1 to 4 rows supported");
+  static_assert(NumCols * NumRows <= 80,
+                "CharLcd: the HD44780 holds at most 80 characters");
+
+ public:
+  static constexpr uint8_t Cols = NumCols;  ///< Characters per row
+  static constexpr uint8_t Rows = NumRows;  ///< Number of rows
+
+  /**
+   * @brief Display RAM address of the first cell of @p row.
+   *
+   * Rows 0 and 1 start at 0x00 and 0x40; rows 2 and 3 continue them
+   * after the first Cols cells.
+   */
+  static constexpr uint8_t rowOffset(uint8_t row) {
+    return static_cast<uint8_t>((row & 1 ? 0x40 : 0x00) + (row & 2 ? Cols : 0));
+  }
+
+  /**
+   * @brief Construct a new display object.
+   *
+   * This constructor reserves the specified SDA and SCL pins, unless
+   * another display already uses them as its bus, and prepares the LCD
+   * object. No I2C communication occurs until begin() is called.
+   *
+   * The configuration is invalid if @p bus already drives a different
+   * SDA/SCL pair: one controller cannot serve two pin pairs. Use another
+   * controller (e.g. Wire1 on ESP32) for a second pair.
+   *
+   * @param sdaP SDA pin number
+   * @param sclP SCL pin number
+   * @param address I2C address of the LCD (default 0x27)
+   * @param bus I2C controller on those pins (default Wire)
+   */
+  CharLcd(uint8_t sdaP, uint8_t sclP, uint8_t address = 0x27,
+          LcdI2cBus& bus = defaultLcdBus()) noexcept
+      : CharLcdBase(sdaP, sclP, address, Cols, Rows, bus),
+        cursorCol(0),
+        cursorRow(NoCursor),
+        dirtyRows(0),
+        nextRow(0),
+        nextCol(0) {
+    memset(frame, ' ', sizeof(frame));
+    memset(shown, ' ', sizeof(shown));
+  }
+
+  /**
+   * @brief Initialize the LCD and I2C bus.
+   *
+   * This function:
+   *  - Initializes the I2C bus
+   *  - Verifies the LCD responds at the configured address
+   *  - Clears the display and enables the backlight
+   *  - Shows anything written before it
+   *
+   * @return true if initialization succeeds
+   * @return false if configuration or I2C validation fails
+   */
+  bool begin() {
+    if (!beginDriver()) return false;
+
+    memset(shown, ' ', sizeof(shown));
+    cursorCol = 0;
+    cursorRow = 0;
+    dirtyRows = AllRows;
+    flush();
+    return true;
+  }
+
+  /**
+   * @brief Clear the entire LCD display.
+   *
+   * Blanks the framebuffer; the panel is updated by the next flush().
+   */
+  void clear() {
+    if (!validConfiguration()) return;
+
+    memset(frame, ' ', sizeof(frame));
+    dirtyRows = AllRows;
+    if (autoFlush) flush();
+  }
+
+  /**
+   * @brief Print text to a specific row of the display.
+   *
+   * The rest of the row is blanked; text longer than the row is cut
+   * off. Rows outside the display are ignored.
+   *
+   * @param row Row index (0 to Rows - 1)
+   * @param text Null-terminated C string to display
+   */
+  void printLine(uint8_t row, const char* text) {
+    if (!validConfiguration() || row >= Rows) return;
+
+    fillRow(row, text, false);
+    if (autoFlush) flush();
+  }
+
+  /**
+   * @brief Print a flash-stored string to a specific row of the display.
+   *
+   * Supports Arduino F("...") strings stored in program memory.
+   *
+   * @param row Row index (0 to Rows - 1)
+   * @param text Flash-resident string
+   */
+  void printLine(uint8_t row, const __FlashStringHelper* text) {
+    if (!validConfiguration() || row >= Rows) return;
+
+    fillRow(row, reinterpret_cast<const char*>(text), true);
+    if (autoFlush) flush();
+  }
+
+  /**
+   * @brief Formatted output into part of a row.
+   *
+   * The field is clipped to the display; a field outside it has no
+   * cells and prints nothing. Printing follows the auto-flush setting
+   * like printLine().
+   *
+   * @code
+   * lcd.field(1, 0, 5).printFixed(temp, 1);
+   * @endcode
+   *
+   * @param row   Row index
+   * @param col   First column
+   * @param width Number of cells
+   */
+  LcdField field(uint8_t row, uint8_t col, uint8_t width) noexcept {
+    if (!validConfiguration() || row >= Rows || col >= Cols) {
+      return LcdField(nullptr, 0, 0, nullptr, nullptr);
+    }
+    if (width > Cols - col) width = static_cast<uint8_t>(Cols - col);
+    return LcdField(&frame[row][col], width, row, &CharLcd::fieldChanged,
+                    this);
+  }
+
+  /**
+   * @brief field() with the position checked at compile time.
+   *
+   * @code
+   * lcd.field<1, 0, 5>().printFixed(temp, 1);
+   * @endcode
+   */
+  template <uint8_t Row, uint8_t Col, uint8_t Width>
+  LcdField field() noexcept {
+    static_assert(Row < Rows, "CharLcd::field: row out of range");
+    static_assert(Col + Width <= Cols, "CharLcd::field: field too wide");
+    return field(Row, Col, Width);
+  }
+
+  /**
+   * @brief Send the cells that differ from what the panel shows.
+   *
+   * Does nothing before begin() has succeeded; begin() flushes whatever
+   * was written before it.
+   *
+   * @return Number of characters sent.
+   */
+  uint8_t flush() {
+    if (!ready()) return 0;
+
+    uint8_t sent = 0;
+    while (dirtyRows) {
+      sent = static_cast<uint8_t>(sent + drain(Rows * Cols));
+    }
+    commit();
+    return sent;
+  }
+
+  /**
+   * @brief Send a bounded slice of the pending changes.
+   *
+   * Call from loop() when auto-flush is off. Each call sends at most
+   * @p maxChars characters (plus the cursor moves they need), so its
+   * duration is bounded by the bus time of that many characters. Later
+   * calls continue where this one stopped.
+   *
+   * @param maxChars Characters to send at most
+   * @return Number of characters sent (0 when the panel is up to date).
+   */
+  uint8_t update(uint8_t maxChars = ARDUINOCOMMON_LCD_UPDATE_CHARS) {
+    if (!ready()) return 0;
+    if (dirtyRows == 0 || maxChars == 0) return 0;
+
+    const uint8_t sent = drain(maxChars);
+    commit();
+    return sent;
+  }
+
+  /**
+   * @brief Check whether the framebuffer has changes not yet flushed.
+   */
+  bool dirty() const noexcept {
+    return memcmp(frame, shown, sizeof(frame)) != 0;
+  }
+
+  /**
+   * @brief Character at a framebuffer cell.
+   *
+   * @return The character, or '\0' if the cell is out of range.
+   */
+  char charAt(uint8_t col, uint8_t row) const noexcept {
+    if (col >= Cols || row >= Rows) return '\0';
+    return frame[row][col];
+  }
+
+ private:
+  char frame[Rows][Cols];  ///< Contents the display should show
+  char shown[Rows][Cols];  ///< Contents last sent to the panel
+  uint8_t cursorCol;       ///< Panel cursor column, if known
+  uint8_t cursorRow;       ///< Panel cursor row (NoCursor if unknown)
+  uint8_t dirtyRows;       ///< Bit per row that may differ from the panel
+  uint8_t nextRow;         ///< Where the next update() resumes
+  uint8_t nextCol;
+
+  static constexpr uint8_t NoCursor = 0xFF;
+  static constexpr uint8_t AllRows = static_cast<uint8_t>((1u << Rows) - 1);
+
+  /// Unchanged cells worth resending to join two runs: a cursor move
+  /// costs one command byte, the same as one character.
+  static constexpr uint8_t MergeGap = 1;
+
+  /**
+   * @brief Copy text into a framebuffer row, padding it with spaces.
+   *
+   * @param progmem true if text points to program memory
+   */
+  void fillRow(uint8_t row, const char* text, bool progmem) {
+    uint8_t col = 0;
+    if (text) {
+      while (col < Cols) {
+        const char c = progmem ? static_cast<char>(pgm_read_byte(text + col))
+                               : text[col];
+        if (c == '\0') break;
+        frame[row][col++] = c;
+      }
+    }
+    while (col < Cols) frame[row][col++] = ' ';
+    markDirty(row);
+  }
+
+  /// Queue a row for update() if it differs from the panel.
+  void markDirty(uint8_t row) {
+    if (memcmp(frame[row], shown[row], Cols) != 0) {
+      dirtyRows = static_cast<uint8_t>(dirtyRows | (1u << row));
+    }
+  }
+
+  /**
+   * @brief Send frame[row][begin, end) and mark it as shown.
+   */
+  void writeRun(uint8_t row, uint8_t begin, uint8_t end) {
+    // The HD44780 advances the cursor after every character, so a run
+    // that starts where the previous one ended needs no cursor move.
+    if (cursorRow != row || cursorCol != begin) {
+      moveTo(static_cast<uint8_t>(rowOffset(row) + begin));
+    }
+
+    const uint8_t len = static_cast<uint8_t>(end - begin);
+    send(&frame[row][begin], len);
+
+    memcpy(&shown[row][begin], &frame[row][begin], len);
+    cursorCol = end;
+    cursorRow = row;
+  }
+
+  /**
+   * @brief Send up to @p budget changed characters, resuming where the
+   * previous call stopped.
+   */
+  uint8_t drain(uint8_t budget) {
+    uint8_t sent = 0;
+
+    // Visit every row once, plus the starting row again from column 0 if
+    // the previous call stopped in the middle of it.
+    for (uint8_t visit = 0; visit <= Rows && sent < budget; ++visit) {
+      const uint8_t row = nextRow;
+      const uint8_t start = nextCol;
+
+      if (dirtyRows & (1u << row)) {
+        uint8_t col = start;
+        while (col < Cols) {
+          if (frame[row][col] == shown[row][col]) {
+            ++col;
+            continue;
+          }
+
+          // Extend the run over later changes separated by at most
+          // MergeGap unchanged cells, then cut it to the remaining budget.
+          uint8_t end = static_cast<uint8_t>(col + 1);
+          for (uint8_t next = end; next < Cols && next - end <= MergeGap;
+               ++next) {
+            if (frame[row][next] != shown[row][next]) {
+              end = static_cast<uint8_t>(next + 1);
+            }
+          }
+          if (end - col > budget - sent) {
+            end = static_cast<uint8_t>(col + (budget - sent));
+          }
+
+          writeRun(row, col, end);
+          sent = static_cast<uint8_t>(sent + (end - col));
+          col = end;
+
+          if (sent == budget && col < Cols) {
+            nextCol = col;
+            return sent;
+          }
+        }
+
+        // The row is clean only if the cells before the starting column
+        // did not change meanwhile.
+        if (start == 0 || memcmp(frame[row], shown[row], start) == 0) {
+          dirtyRows = static_cast<uint8_t>(dirtyRows & ~(1u << row));
+        }
+      }
+
+      nextRow = static_cast<uint8_t>(row + 1 < Rows ? row + 1 : 0);
+      nextCol = 0;
+    }
+    return sent;
+  }
+
+  /// LcdField change callback: mark the row dirty and auto-flush.
+  static void fieldChanged(void* context, uint8_t row) {
+    CharLcd* self = static_cast<CharLcd*>(context);
+    self->markDirty(row);
+    if (self->autoFlush) self->flush();
+  }
+};
+
+}  // namespace Display
+}  // namespace ArduinoCommon
+
+#endif
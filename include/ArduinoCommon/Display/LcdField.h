@@ -0,0 +1,160 @@
+#ifndef ARDUINOCOMMON_DISPLAY_LCDFIELD_H
+#define ARDUINOCOMMON_DISPLAY_LCDFIELD_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+namespace ArduinoCommon {
+namespace Display {
+
+/**
+ * @brief A fixed-width region of one framebuffer row, with formatted
+ * output that needs no printf, String or temporary buffers.
+ *
+ * Obtained from the display (e.g. LCD1602::field()); every print call
+ * overwrites the whole field, aligned and padded, and then lets the
+ * display flush as usual.
+ *
+ * Values that do not fit are shown as '#' characters rather than being
+ * cut off, so a truncated number is never mistaken for a real one; text
+ * is cut off at the field width.
+ *
+ * @code
+ * lcd.field(0, 0, 6).left().print(F("Temp"));
+ * lcd.field(0, 6, 6).printFixed(temperature, 1);     // "  23.5"
+ * lcd.field(1, 0, 2).zeroPad().printUnsigned(hours);  // "07"
+ * lcd.field(1, 12, 4).printPercent(moisture);         // " 42%"
+ * @endcode
+ *
+ * Argument types select the conversion, so there is no format string
+ * that can disagree with its arguments.
+ */
+class LcdField {
+ public:
+  /// Called after the field's cells changed.
+  using ChangeFn = void (*)(void* context, uint8_t row);
+
+  enum class Align : uint8_t { Left, Right };
+
+  /// Maximum decimals for printFixed()/printScaled().
+  static constexpr uint8_t MaxDecimals = 6;
+
+  /**
+   * @brief Field of @p numCells cells starting at @p start.
+   *
+   * Numbers are right-aligned and text left-aligned unless an alignment
+   * is chosen with left() or right().
+   *
+   * @param start    First cell of the field in the framebuffer
+   * @param numCells Width of the field
+   * @param rowIndex Row passed to @p changeFn
+   * @param changeFn Called after every print (may be nullptr)
+   * @param ctx      Passed to @p changeFn
+   */
+  LcdField(char* start, uint8_t numCells, uint8_t rowIndex, ChangeFn changeFn,
+           void* ctx) noexcept
+      : cells(start),
+        width(numCells),
+        row(rowIndex),
+        onChange(changeFn),
+        context(ctx) {}
+
+  /// Align the output to the left edge of the field.
+  LcdField& left() noexcept {
+    align = Align::Left;
+    explicitAlign = true;
+    return *this;
+  }
+
+  /// Align the output to the right edge of the field.
+  LcdField& right() noexcept {
+    align = Align::Right;
+    explicitAlign = true;
+    return *this;
+  }
+
+  /// Pad numbers with leading zeros (after the sign) instead of spaces.
+  LcdField& zeroPad() noexcept {
+    zeros = true;
+    return *this;
+  }
+
+  /// Width of the field in cells.
+  uint8_t size() const noexcept { return width; }
+
+  /// @return false if the text was cut off.
+  bool print(const char* text);
+
+  /// Print a flash-stored F("...") string.
+  bool print(const __FlashStringHelper* text);
+
+  /// Print a single character.
+  bool print(char c);
+
+  /// @return false if the value did not fit (the field shows '#').
+  bool printInt(long value);
+
+  bool printUnsigned(unsigned long value);
+
+  /**
+   * @brief Print a value with a fixed number of decimals, rounded.
+   *
+   * @param value    Value to print
+   * @param decimals Digits after the decimal point (0..MaxDecimals)
+   */
+  bool printFixed(float value, uint8_t decimals);
+
+  /**
+   * @brief Print an integer holding a fixed-point value.
+   *
+   * printScaled(235, 1) prints "23.5". Avoids floating point entirely.
+   */
+  bool printScaled(long scaled, uint8_t decimals);
+
+  /// Print a whole percentage, e.g. "42%".
+  bool printPercent(int percent);
+
+  /// Print a percentage with decimals, e.g. "42.5%".
+  bool printPercent(float percent, uint8_t decimals);
+
+  /**
+   * @brief Blank the field.
+   */
+  void clear();
+
+ private:
+  char* cells;
+  uint8_t width;
+  uint8_t row;
+  ChangeFn onChange;
+  void* context;
+  Align align = Align::Left;
+  bool explicitAlign = false;
+  bool zeros = false;
+
+  /**
+   * @brief Place formatted text into the field.
+   *
+   * @param text    Characters to show
+   * @param len     Number of characters
+   * @param numeric true for numbers: right-aligned by default, zero
+   *                padding allowed, '#' when too wide
+   * @return false if the text did not fit.
+   */
+  bool place(const char* text, uint8_t len, bool numeric);
+
+  /**
+   * @brief Format a scaled integer with an optional suffix and place it.
+   */
+  bool placeNumber(long scaled, uint8_t decimals, char suffix);
+
+  /// Fill the field with '#'. @return false
+  bool overflow();
+
+  void changed();
+};
+
+}  // namespace Display
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef ARDUINOCOMMON_DISPLAY_PCF8574LCD_H
+#define ARDUINOCOMMON_DISPLAY_PCF8574LCD_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#ifdef ARDUINOCOMMON_TESTING
+#include "FakeTwoWire.h"
+#else
+#include <Wire.h>
+#endif
+
+/**
+ * @brief Bytes the driver packs into one I2C transmission.
+ *
+ * Must not exceed the Wire library's transmit buffer; defaults to the
+ * size the core advertises, or 32 (the AVR buffer) if it does not.
+ */
+#ifndef ARDUINOCOMMON_LCD_I2C_BUFFER
+#if defined(ARDUINOCOMMON_TESTING)
+#define ARDUINOCOMMON_LCD_I2C_BUFFER FakeTwoWire::BufferLength
+#elif defined(I2C_BUFFER_LENGTH)
+#define ARDUINOCOMMON_LCD_I2C_BUFFER I2C_BUFFER_LENGTH
+#elif defined(BUFFER_LENGTH)
+#define ARDUINOCOMMON_LCD_I2C_BUFFER BUFFER_LENGTH
+#else
+#define ARDUINOCOMMON_LCD_I2C_BUFFER 32
+#endif
+#endif
+
+namespace ArduinoCommon {
+namespace Display {
+
+#ifdef ARDUINOCOMMON_TESTING
+using LcdI2cBus = FakeTwoWire;
+inline LcdI2cBus& defaultLcdBus() { return fakeWire(); }
+#else
+using LcdI2cBus = TwoWire;
+inline LcdI2cBus& defaultLcdBus() { return Wire; }
+#endif
+
+/**
+ * @brief HD44780 character LCD driver for PCF8574 I2C backpacks.
+ *
+ * Drives the common "LCD1602 I2C" backpack wiring (P0 = RS, P1 = RW,
+ * P2 = EN, P3 = backlight, P4..P7 = D4..D7) in 4-bit mode.
+ *
+ * Every expander write normally costs a whole I2C transaction; this
+ * driver instead queues the writes of many nibbles (data plus enable
+ * pulse, 2 bytes per nibble) in a buffer and sends them in a single
+ * transmission of up to ARDUINOCOMMON_LCD_I2C_BUFFER bytes. Writes are
+ * only sent when the buffer is full or commit() is called, so callers
+ * must commit() after a batch of output. Commands that need more than
+ * the bus time to execute (clear, home, initialization) are committed
+ * and waited for internally.
+ *
+ * The HD44780 needs 37 us per character; at 400 kHz a character takes
+ * about 90 us on the bus, so fast mode needs no extra delays.
+ */
+class Pcf8574Lcd {
+ public:
+  static constexpr uint16_t BufferSize = ARDUINOCOMMON_LCD_I2C_BUFFER;
+  static_assert(BufferSize >= 3,
+                "ARDUINOCOMMON_LCD_I2C_BUFFER must hold an RS byte and an "
+                "enable pulse (3 bytes)");
+
+  /**
+   * @brief Construct a driver for the backpack at @p addr.
+   *
+   * No I2C traffic happens until init().
+   *
+   * @param addr    I2C address of the PCF8574 (usually 0x27 or 0x3F)
+   * @param numCols Characters per row
+   * @param numRows Number of rows (1 to 4)
+   * @param bus     I2C bus the backpack is on
+   */
+  Pcf8574Lcd(uint8_t addr, uint8_t numCols, uint8_t numRows,
+             LcdI2cBus& bus = defaultLcdBus()) noexcept;
+
+  /**
+   * @brief Check that the backpack acknowledges its address.
+   */
+  bool probe();
+
+  /**
+   * @brief Run the HD44780 4-bit initialization sequence.
+   *
+   * Leaves the display on, cleared, with the cursor hidden and the
+   * backlight in its current state.
+   */
+  void init();
+
+  /// Clear the display and home the cursor (waits ~2 ms).
+  void clear();
+
+  /// Turn the backlight on.
+  void backlight();
+
+  /// Turn the backlight off.
+  void noBacklight();
+
+  /**
+   * @brief Move the cursor.
+   *
+   * Rows 2 and 3 follow the usual layout where they continue rows 0 and
+   * 1 in display RAM.
+   */
+  void setCursor(uint8_t col, uint8_t row);
+
+  /**
+   * @brief Move the cursor to a display RAM address.
+   *
+   * For callers that know the row offsets at compile time.
+   */
+  void setAddress(uint8_t ddram);
+
+  /**
+   * @brief Queue @p len characters at the cursor.
+   *
+   * @return Number of characters queued.
+   */
+  size_t write(const char* text, size_t len);
+
+  /// Queue a null-terminated string at the cursor.
+  size_t print(const char* text);
+
+  /**
+   * @brief Send the queued bytes.
+   *
+   * @return true if the backpack acknowledged the last transmission.
+   */
+  bool commit();
+
+  /// Bus the backpack is on.
+  LcdI2cBus& bus() noexcept { return i2c; }
+
+ private:
+  LcdI2cBus& i2c;
+  uint8_t address;
+  uint8_t cols;
+  uint8_t rows;
+  uint8_t backlightBit;
+  uint8_t lastOutput;       ///< Last byte queued for the expander
+  bool lastAck;             ///< Result of the last transmission
+  uint8_t pending[BufferSize];
+  uint16_t pendingLength;
+
+  static constexpr uint8_t Rs = 0x01;
+  static constexpr uint8_t En = 0x04;
+  static constexpr uint8_t Backlight = 0x08;
+
+  /// Queue one nibble (in the upper 4 bits of @p nibble) with an
+  /// enable pulse.
+  void sendNibble(uint8_t nibble, uint8_t rs);
+
+  /// Queue a command (rs = 0) or data byte (rs = Rs).
+  void sendByte(uint8_t value, uint8_t rs);
+
+  void command(uint8_t value) { sendByte(value, 0); }
+
+  void queue(uint8_t value);
+};
+
+}  // namespace Display
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef ARDUINOCOMMON_SENSORS_ADCRESOLUTION_H
+#define ARDUINOCOMMON_SENSORS_ADCRESOLUTION_H
+
+#include <Arduino.h>
+
+// Native ADC resolution of the target and whether the core lets us select
+// it with analogReadResolution(). Cores default to 10-bit results for
+// compatibility, even when the hardware can do better.
+#if defined(ARDUINO_ARCH_RENESAS)
+#define ARDUINOCOMMON_ADC_NATIVE_BITS 14
+#define ARDUINOCOMMON_HAS_ANALOG_READ_RESOLUTION 1
+#elif defined(ESP32) || defined(ARDUINO_ARCH_ESP32) || \
+    defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_RP2040) || \
+    defined(ARDUINO_ARCH_MBED)
+#define ARDUINOCOMMON_ADC_NATIVE_BITS 12
+#define ARDUINOCOMMON_HAS_ANALOG_READ_RESOLUTION 1
+#else
+#define ARDUINOCOMMON_ADC_NATIVE_BITS 10
+#define ARDUINOCOMMON_HAS_ANALOG_READ_RESOLUTION 0
+#endif
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Global registry of the ADC result width used by analogRead().
+ *
+ * analogReadResolution() affects every analog pin, so the setting is kept
+ * in one place (like PinManager) and sensors query it to know the range
+ * of their raw readings.
+ */
+class AdcResolution {
+ private:
+  /// Bits currently returned by analogRead().
+  static uint8_t currentBits;
+
+ public:
+  /// Widest result the ADC of this board can produce.
+  static constexpr uint8_t NativeBits = ARDUINOCOMMON_ADC_NATIVE_BITS;
+
+  /**
+   * @brief Switch analogRead() to the board's native resolution.
+   *
+   * On boards without analogReadResolution() this is a no-op and the
+   * resolution stays at 10 bits.
+   *
+   * @return uint8_t The resolution now in effect.
+   */
+  static uint8_t useNative();
+
+  /**
+   * @brief Select a specific analogRead() resolution.
+   *
+   * @param bits Requested result width (8..NativeBits).
+   * @return true  If the resolution was applied.
+   * @return false If it is out of range or the core cannot change it.
+   */
+  static bool set(uint8_t bits);
+
+  /**
+   * @brief Result width currently returned by analogRead().
+   */
+  static uint8_t bits();
+
+  /**
+   * @brief Largest raw value for a given result width.
+   */
+  static constexpr int32_t maxValue(uint8_t bits) {
+    return (static_cast<int32_t>(1) << bits) - 1;
+  }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
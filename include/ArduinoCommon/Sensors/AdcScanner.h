@@ -0,0 +1,202 @@
+#ifndef ARDUINOCOMMON_SENSORS_ADCSCANNER_H
+#define ARDUINOCOMMON_SENSORS_ADCSCANNER_H
+
+#include <Arduino.h>
+#include <ArduinoCommon/Utils/RingBuffer.h>
+
+#ifndef ARDUINOCOMMON_ADC_MAX_CHANNELS
+#define ARDUINOCOMMON_ADC_MAX_CHANNELS 8
+#endif
+
+#ifndef ARDUINOCOMMON_ADC_BUFFER_DEPTH
+#define ARDUINOCOMMON_ADC_BUFFER_DEPTH 8
+#endif
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+class AdcScanner;
+
+/**
+ * @brief Interface for hardware (or simulated) ADC scan backends.
+ *
+ * A backend is responsible for converting every registered pin and
+ * handing each result to AdcScanner::push(). Interrupt- or DMA-driven
+ * backends call push() from their completion handler and can leave
+ * poll() empty; polled backends do their work in poll().
+ */
+class IAdcBackend {
+ public:
+  virtual ~IAdcBackend() = default;
+
+  /**
+   * @brief Prepare the backend to scan the given pins.
+   *
+   * @param scanner Scanner that receives conversion results.
+   * @param pins    Array of analog pins, indexed by channel.
+   * @param count   Number of entries in @p pins.
+   * @return true  If the backend is ready to scan.
+   * @return false If the configuration is not supported.
+   */
+  virtual bool begin(AdcScanner& scanner, const uint8_t* pins,
+                     uint8_t count) = 0;
+
+  /**
+   * @brief Give a polled backend a chance to run.
+   *
+   * Called from AdcScanner::update(). Must not block for longer than a
+   * single conversion.
+   */
+  virtual void poll() {}
+
+  /**
+   * @brief Stop scanning and release any hardware resources.
+   */
+  virtual void end() {}
+};
+
+/**
+ * @brief Portable backend that converts one channel per poll() via
+ * analogRead().
+ *
+ * Works on every core, including the Uno R4, and spreads the ADC cost
+ * over the main loop instead of reading every channel back to back.
+ */
+class AnalogReadAdcBackend : public IAdcBackend {
+ private:
+  AdcScanner* _scanner = nullptr;
+  const uint8_t* _pins = nullptr;
+  uint8_t _count = 0;
+  uint8_t _next = 0;
+
+ public:
+  bool begin(AdcScanner& scanner, const uint8_t* pins, uint8_t count) override;
+  void poll() override;
+  void end() override;
+};
+
+/**
+ * @brief Continuous background sampler for a set of analog channels.
+ *
+ * Each registered pin gets its own lock-free ring buffer that the backend
+ * fills in the background. Consumers read the most recent conversion with
+ * latest() (a plain memory read, no ADC access) or drain the history with
+ * pop().
+ *
+ * Typical usage:
+ * @code
+ * AnalogReadAdcBackend backend;
+ * AdcScanner scanner(backend);
+ * soil1.attachScanner(&scanner);
+ * soil2.attachScanner(&scanner);
+ * scanner.begin();
+ *
+ * void loop() {
+ *   scanner.update();
+ *   int raw = soil1.readRaw();  // reads from memory
+ * }
+ * @endcode
+ */
+class AdcScanner {
+ public:
+  /// Maximum number of channels a scanner can track.
+  static constexpr uint8_t MaxChannels = ARDUINOCOMMON_ADC_MAX_CHANNELS;
+  /// Number of samples kept per channel.
+  static constexpr uint8_t BufferDepth = ARDUINOCOMMON_ADC_BUFFER_DEPTH;
+
+ private:
+  IAdcBackend& _backend;
+  uint8_t _pins[MaxChannels];
+  uint8_t _count;
+  bool _running;
+  Utils::RingBuffer<uint16_t, BufferDepth> _buffers[MaxChannels];
+
+ public:
+  /**
+   * @brief Construct a scanner driven by the given backend.
+   *
+   * @param backend Non-owning reference; must outlive the scanner.
+   */
+  explicit AdcScanner(IAdcBackend& backend);
+
+  /**
+   * @brief Register a pin for scanning.
+   *
+   * Registering the same pin twice returns the existing channel. Pins can
+   * only be added before begin().
+   *
+   * @param pin Analog pin to scan.
+   * @return int The channel index, or -1 if the scanner is running or full.
+   */
+  int addChannel(uint8_t pin);
+
+  /**
+   * @brief Look up the channel index of a registered pin.
+   *
+   * @return int The channel index, or -1 if the pin is not registered.
+   */
+  int channelForPin(uint8_t pin) const;
+
+  /**
+   * @brief Start the backend scanning all registered channels.
+   *
+   * @return true  If the backend accepted the channel list.
+   * @return false If no channels are registered or the backend failed.
+   */
+  bool begin();
+
+  /**
+   * @brief Stop scanning. Buffered values remain readable.
+   */
+  void end();
+
+  /**
+   * @brief Drive polled backends; call regularly from loop().
+   */
+  void update();
+
+  /**
+   * @brief Store a conversion result (producer side).
+   *
+   * Intended to be called by backends, including from interrupt context.
+   *
+   * @param channel Channel index returned by addChannel().
+   * @param value   Raw conversion result.
+   */
+  void push(uint8_t channel, uint16_t value);
+
+  /**
+   * @brief Most recent conversion for a channel.
+   *
+   * @return int The raw value, or -1 if the channel is invalid or has not
+   *             been converted yet.
+   */
+  int latest(uint8_t channel) const;
+
+  /**
+   * @brief Remove the oldest buffered conversion for a channel.
+   *
+   * @return true If a value was returned in @p value.
+   */
+  bool pop(uint8_t channel, uint16_t& value);
+
+  /**
+   * @brief Number of buffered conversions waiting to be popped.
+   */
+  uint8_t available(uint8_t channel) const;
+
+  /**
+   * @brief Number of registered channels.
+   */
+  uint8_t channelCount() const { return _count; }
+
+  /**
+   * @brief Whether begin() has succeeded and end() has not been called.
+   */
+  bool isRunning() const { return _running; }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
@@ -2,10 +2,41 @@
 #define ARDUINOCOMMON_SENSORS_ANALOGSENSOR_H
 
 #include <Arduino.h>
+#include <ArduinoCommon/Sensors/SensorWatch.h>
 
 namespace ArduinoCommon {
 namespace Sensors {
 
+/**
+ * @brief Print a labelled sensor reading, e.g. "Soil: 76%".
+ *
+ * Shared by the virtual (IAnalogSensor) and static (StaticAnalogSensor)
+ * logging helpers so both produce identical output.
+ *
+ * @param out          Destination stream.
+ * @param label        Caller-supplied label, or nullptr.
+ * @param defaultLabel Label used when @p label is nullptr.
+ * @param value        Reading to print.
+ * @param suffix       Optional unit suffix (e.g. F("%")), or nullptr.
+ */
+inline void printReading(Stream& out, const char* label,
+                         const __FlashStringHelper* defaultLabel, int value,
+                         const __FlashStringHelper* suffix = nullptr) {
+  if (label) {
+    out.print(label);
+    out.print(F(": "));
+  } else {
+    out.print(defaultLabel);
+  }
+
+  if (suffix) {
+    out.print(value);
+    out.println(suffix);
+  } else {
+    out.println(value);
+  }
+}
+
 /**
  * @brief Interface and common utilities for analog sensors.
  *
@@ -60,6 +91,135 @@ class IAnalogSensor {
    */
   virtual int readPercent() const { return -1; }
 
+  /**
+   * @brief Convert a raw reading into a percentage.
+   *
+   * Applies the same mapping as readPercent() to a value that was read
+   * elsewhere (e.g. an averaged or filtered reading), without touching
+   * the ADC.
+   *
+   * The default implementation returns -1 (percentages not supported).
+   *
+   * @param raw A raw reading in this sensor's range.
+   * @return int A percentage in [0,100], or a negative value if not
+   *             supported.
+   */
+  virtual int rawToPercent(int /*raw*/) const { return -1; }
+
+  /**
+   * @brief Effective resolution of the values returned by readRaw().
+   *
+   * Implementations that oversample report more bits than the ADC
+   * natively provides. Raw readings lie in [0, 2^bits - 1].
+   *
+   * @return uint8_t Number of significant bits (10 by default).
+   */
+  virtual uint8_t resolutionBits() const { return 10; }
+
+  /**
+   * @brief Enable oversampling and decimation for extra resolution.
+   *
+   * Each reading accumulates 4^extraBits conversions and shifts the sum
+   * right by extraBits, gaining @p extraBits of effective resolution
+   * (provided the signal carries at least 1 LSB of noise). Integer-only.
+   *
+   * The default implementation only accepts 0 (no oversampling).
+   *
+   * @param extraBits Additional bits of resolution; 0 disables.
+   * @return true  If the mode was applied.
+   * @return false If the sensor does not support the requested mode.
+   */
+  virtual bool setOversampling(uint8_t extraBits) { return extraBits == 0; }
+
+  /**
+   * @brief Start a non-blocking averaged sampling run.
+   *
+   * Instead of blocking the caller with delay() between samples, the
+   * sensor collects @p samples readings spaced @p intervalMs apart as
+   * update() is called from the main loop. Once isReady() returns true,
+   * the averaged result is available from sampledRaw().
+   *
+   * The default implementation does not support asynchronous sampling
+   * and returns false.
+   *
+   * @param samples    Number of samples to average (must be > 0).
+   * @param intervalMs Minimum time between two consecutive samples.
+   * @return true  If sampling was started.
+   * @return false If the sensor is not configured or does not support
+   *               asynchronous sampling.
+   */
+  virtual bool startSampling(uint8_t /*samples*/, uint16_t /*intervalMs*/) {
+    return false;
+  }
+
+  /**
+   * @brief Advance the asynchronous sampling state machine.
+   *
+   * Call this regularly from loop(). Each call takes at most one sample
+   * and never blocks. Does nothing if no sampling run is active.
+   */
+  virtual void update() {}
+
+  /**
+   * @brief Check whether the last sampling run has completed.
+   *
+   * @return true  If a result is available from sampledRaw().
+   * @return false If sampling is still in progress or was never started.
+   */
+  virtual bool isReady() const { return false; }
+
+  /**
+   * @brief Get the averaged result of the last completed sampling run.
+   *
+   * @return int The averaged raw reading, or a negative value if no
+   *             sampling run has completed yet.
+   */
+  virtual int sampledRaw() const { return -1; }
+
+  /**
+   * @brief Register a threshold watch with hysteresis.
+   *
+   * The callback fires from update() when a completed reading drops
+   * below @p threshold (WatchEvent::Below) and again when it recovers to
+   * threshold + hysteresis (WatchEvent::Above). See WatchList.
+   *
+   * The default implementation does not support watches and returns -1.
+   *
+   * @return int8_t A watch id for removeWatch(), or -1 on failure.
+   */
+  virtual int8_t addThresholdWatch(WatchSource /*source*/,
+                                   int16_t /*threshold*/,
+                                   int16_t /*hysteresis*/,
+                                   WatchCallback /*callback*/,
+                                   void* /*context*/ = nullptr) {
+    return -1;
+  }
+
+  /**
+   * @brief Register a deadband watch.
+   *
+   * The callback fires from update() when a completed reading differs
+   * from the last reported one by more than @p deadband.
+   *
+   * The default implementation does not support watches and returns -1.
+   *
+   * @return int8_t A watch id for removeWatch(), or -1 on failure.
+   */
+  virtual int8_t addDeadbandWatch(WatchSource /*source*/,
+                                  int16_t /*deadband*/,
+                                  WatchCallback /*callback*/,
+                                  void* /*context*/ = nullptr) {
+    return -1;
+  }
+
+  /**
+   * @brief Remove a watch registered with addThresholdWatch() or
+   * addDeadbandWatch().
+   *
+   * @return true If the watch existed and was removed.
+   */
+  virtual bool removeWatch(int8_t /*id*/) { return false; }
+
   /**
    * @brief Log a raw sensor reading to the given Stream.
    *
@@ -79,14 +239,7 @@ class IAnalogSensor {
     const int value = readRaw();
     if (value < 0) return;
 
-    if (label) {
-      out.print(label);
-      out.print(F(": "));
-    } else {
-      out.print(F("Raw: "));
-    }
-
-    out.println(value);
+    printReading(out, label, F("Raw: "), value);
   }
 
   /**
@@ -108,15 +261,7 @@ class IAnalogSensor {
     const int value = readPercent();
     if (value < 0) return;
 
-    if (label) {
-      out.print(label);
-      out.print(F(": "));
-    } else {
-      out.print(F("Percent: "));
-    }
-
-    out.print(value);
-    out.println(F("%"));
+    printReading(out, label, F("Percent: "), value, F("%"));
   }
 };
 
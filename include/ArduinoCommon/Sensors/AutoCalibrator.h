@@ -0,0 +1,129 @@
+#ifndef ARDUINOCOMMON_SENSORS_AUTOCALIBRATOR_H
+#define ARDUINOCOMMON_SENSORS_AUTOCALIBRATOR_H
+
+#include <Arduino.h>
+#include <ArduinoCommon/Sensors/SoilCalibration.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Tuning parameters for AutoCalibrator.
+ */
+struct AutoCalibrationConfig {
+  /// True if the dry reading is the high extreme (capacitive probes).
+  bool dryIsHigh = true;
+  /// Each decay step relaxes the extremes toward the current reading by
+  /// 1/2^decayShift of the gap.
+  uint8_t decayShift = 6;
+  /// Minimum time between two decay steps (0: one step per reading).
+  /// Soil may stay moist for weeks, so the default is one day: about 10 %
+  /// of the gap per week.
+  uint32_t decayIntervalMs = 24UL * 60UL * 60UL * 1000UL;
+  /// Consecutive readings beyond an extreme needed to move it.
+  uint8_t confirmSamples = 3;
+  /// Readings below this are treated as faults and ignored.
+  int16_t minValidRaw = 1;
+  /// Readings above this are treated as faults and ignored
+  /// (-1: one below full scale of the sensor).
+  int16_t maxValidRaw = -1;
+  /// Minimum dry/wet distance before a calibration is reported.
+  int16_t minSpan = 50;
+  /// Minimum accepted readings before a calibration is reported.
+  uint16_t minSamples = 20;
+  /// Drift (raw counts, either point) that justifies a storage write.
+  int16_t persistThreshold = 10;
+  /// Minimum time between two storage writes.
+  uint32_t persistIntervalMs = 6UL * 60UL * 60UL * 1000UL;
+};
+
+/**
+ * @brief Learns dry/wet calibration points from observed readings.
+ *
+ * Tracks the highest and lowest plausible readings seen so far:
+ *  - out-of-range readings (shorted or disconnected probe) are dropped;
+ *  - a new extreme is only accepted after confirmSamples consecutive
+ *    readings beyond it, and then only as far as the least extreme of
+ *    those readings, so single spikes are rejected;
+ *  - both extremes slowly decay toward current readings, at most once
+ *    per decayIntervalMs, so a sensor that drifts (or an old outlier)
+ *    is forgotten over weeks. Decay stops while it would bring the
+ *    range below minSpan, so steady readings never wipe out a
+ *    calibration.
+ *
+ * Extremes are kept in Q8 fixed point so slow decay does not round away.
+ */
+class AutoCalibrator {
+ private:
+  AutoCalibrationConfig _config;
+  int32_t _highQ8;
+  int32_t _lowQ8;
+  int32_t _highCandidateQ8;
+  int32_t _lowCandidateQ8;
+  uint8_t _highConfirm;
+  uint8_t _lowConfirm;
+  uint16_t _samples;
+  uint32_t _lastDecayMs;
+  bool _decayClockStarted;
+  SoilCalibration _reported;
+
+  /// Whether a decay step is due at @p nowMs; starts the clock if needed.
+  bool decayDue(uint32_t nowMs);
+
+  /// Relax both extremes toward @p valueQ8, unless that would bring the
+  /// range below minSpan.
+  void decayToward(int32_t valueQ8);
+
+ public:
+  explicit AutoCalibrator(
+      const AutoCalibrationConfig& config = AutoCalibrationConfig());
+
+  /**
+   * @brief Replace the configuration; learned state is kept.
+   */
+  void configure(const AutoCalibrationConfig& config);
+
+  const AutoCalibrationConfig& config() const { return _config; }
+
+  /**
+   * @brief Forget all observations.
+   */
+  void reset();
+
+  /**
+   * @brief Start from an existing calibration instead of from scratch.
+   *
+   * The seeded extremes count as fully confirmed (minSamples reached).
+   */
+  void seed(const SoilCalibration& calibration);
+
+  /**
+   * @brief Feed one reading.
+   *
+   * @param raw   Raw reading (same units as the calibration).
+   * @param nowMs Time of the reading, for decayIntervalMs.
+   * @return true If calibration() now differs from the last value that
+   *              was reported through a true return.
+   */
+  bool observe(int raw, uint32_t nowMs);
+
+  /**
+   * @brief Feed one reading taken now (millis()).
+   */
+  bool observe(int raw) { return observe(raw, millis()); }
+
+  /**
+   * @brief Whether enough data has been seen to report a calibration.
+   */
+  bool hasCalibration() const;
+
+  /**
+   * @brief Current learned calibration (invalid until hasCalibration()).
+   */
+  SoilCalibration calibration() const;
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef ARDUINOCOMMON_SENSORS_CALIBRATIONCURVE_H
+#define ARDUINOCOMMON_SENSORS_CALIBRATIONCURVE_H
+
+#include <Arduino.h>
+#include <ArduinoCommon/Sensors/SoilCalibration.h>
+
+#ifndef ARDUINOCOMMON_CALIBRATION_MAX_POINTS
+#define ARDUINOCOMMON_CALIBRATION_MAX_POINTS 8
+#endif
+
+#ifndef ARDUINOCOMMON_CALIBRATION_LUT_SIZE
+#define ARDUINOCOMMON_CALIBRATION_LUT_SIZE 64
+#endif
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief One breakpoint of a piecewise-linear calibration curve.
+ */
+struct CalibrationPoint {
+  int16_t raw;      ///< Raw reading at this breakpoint.
+  uint8_t percent;  ///< Moisture percentage at this breakpoint (0..100).
+  uint8_t reserved;
+};
+
+/**
+ * @brief Multi-point (version 2) calibration record.
+ *
+ * The first five bytes share their layout with SoilCalibration (dryRaw,
+ * wetRaw, version), so a stored record can be read as a SoilCalibration
+ * first and dispatched on its version field: version 1 is the classic
+ * two-point record, version 2 is this struct.
+ *
+ * Two curve kinds are supported:
+ *  - Piecewise: up to MaxPoints breakpoints, strictly increasing in raw,
+ *    linearly interpolated and clamped at the ends.
+ *  - Polynomial: percent = c0 + c1*x + c2*x^2 + c3*x^3 for raw x in
+ *    [min(dryRaw, wetRaw), max(dryRaw, wetRaw)], clamped to [0,100].
+ *
+ * For piecewise curves dryRaw/wetRaw are filled with the raw values of
+ * the lowest and highest percentage points.
+ */
+struct CalibrationCurve {
+  static constexpr uint8_t Version = 2;
+  static constexpr uint8_t MaxPoints = ARDUINOCOMMON_CALIBRATION_MAX_POINTS;
+  static constexpr uint8_t MaxCoefficients = 4;
+
+  enum class Kind : uint8_t { Piecewise = 1, Polynomial = 2 };
+
+  int16_t dryRaw = -1;
+  int16_t wetRaw = -1;
+  uint8_t version = Version;
+  Kind kind = Kind::Piecewise;
+  uint8_t count = 0;  ///< Number of points or coefficients in use.
+  uint8_t reserved = 0;
+  CalibrationPoint points[MaxPoints] = {};
+  float coefficients[MaxCoefficients] = {};
+
+  /**
+   * @brief Build a piecewise-linear curve from breakpoints.
+   *
+   * @param points Breakpoints sorted by strictly increasing raw value.
+   * @param count  Number of breakpoints (2..MaxPoints).
+   * @return CalibrationCurve The curve; check isValid().
+   */
+  static CalibrationCurve piecewise(const CalibrationPoint* points,
+                                    uint8_t count);
+
+  /**
+   * @brief Build a polynomial curve.
+   *
+   * @param coefficients c0..c(count-1), lowest order first.
+   * @param count        Number of coefficients (1..MaxCoefficients).
+   * @param dryRaw       Raw value at the dry end of the valid range.
+   * @param wetRaw       Raw value at the wet end of the valid range.
+   * @return CalibrationCurve The curve; check isValid().
+   */
+  static CalibrationCurve polynomial(const float* coefficients, uint8_t count,
+                                     int16_t dryRaw, int16_t wetRaw);
+
+  /**
+   * @brief Express a two-point calibration as a curve.
+   */
+  static CalibrationCurve fromLinear(const SoilCalibration& calibration);
+
+  /**
+   * @brief Check the record for structural consistency.
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Evaluate the curve (slow path; used to build the LUT).
+   *
+   * @param raw      Raw reading.
+   * @param clampRaw If false, raw values beyond the curve's range
+   *                 extrapolate its end segment instead of clamping.
+   * @return float Percentage in [0,100].
+   */
+  float evaluate(int32_t raw, bool clampRaw = true) const;
+
+  /// Lowest raw value covered by the curve.
+  int16_t minRaw() const;
+  /// Highest raw value covered by the curve.
+  int16_t maxRaw() const;
+};
+
+/**
+ * @brief Lookup table compiled from a CalibrationCurve.
+ *
+ * Conversions use no division and no floating point. Values are kept in
+ * Q7 (percent * 128) so interpolation stays smooth.
+ *
+ * Piecewise curves keep one entry per breakpoint with the slope of the
+ * segment that follows it. A conversion finds the segment (at most
+ * MaxPoints comparisons) and interpolates on it, so results match
+ * CalibrationCurve::evaluate() to within rounding however close and
+ * steep the breakpoints are.
+ *
+ * Polynomial curves are sampled at Size evenly spaced raw values,
+ * 2^shift counts apart: a conversion is a subtraction, a shift, two
+ * table reads and a short interpolation. This is accurate as long as
+ * the curve does not bend sharply within 1/Size of its range.
+ */
+class CalibrationLut {
+ public:
+  /// Number of table entries (RAM use is 2 bytes per entry).
+  static constexpr uint8_t Size = ARDUINOCOMMON_CALIBRATION_LUT_SIZE;
+
+  /// Fraction bits of the per-segment slopes.
+  static constexpr uint8_t SlopeShift = 16;
+
+ private:
+  struct Segment {
+    int16_t raw;    ///< Raw value of the segment's first breakpoint.
+    int16_t q7;     ///< Percent * 128 at that breakpoint.
+    int32_t slope;  ///< Q7 per raw count, in 1/2^SlopeShift units.
+  };
+
+  union {
+    uint16_t _table[Size];  ///< Polynomial curves.
+    Segment _segments[CalibrationCurve::MaxPoints];  ///< Piecewise curves.
+  };
+  int16_t _lo = 0;
+  int16_t _hi = 0;
+  uint8_t _loPercent = 0;
+  uint8_t _hiPercent = 0;
+  uint8_t _shift = 0;
+  uint8_t _last = 0;      ///< Index of the last used entry.
+  uint8_t _segmentCount = 0;  ///< 0 for a sampled (polynomial) table.
+  bool _valid = false;
+
+  void buildSegments(const CalibrationCurve& curve);
+  void buildTable(const CalibrationCurve& curve);
+
+ public:
+  /**
+   * @brief Expand a curve into the table.
+   *
+   * @return true If the curve was valid and the table was built.
+   */
+  bool build(const CalibrationCurve& curve);
+
+  /**
+   * @brief Drop the table.
+   */
+  void clear() { _valid = false; }
+
+  /**
+   * @brief Whether build() succeeded.
+   */
+  bool valid() const { return _valid; }
+
+  /**
+   * @brief Convert a raw reading to a percentage in [0,100].
+   *
+   * @pre valid() is true.
+   */
+  int toPercent(int raw) const {
+    if (raw <= _lo) return _loPercent;
+    if (raw >= _hi) return _hiPercent;
+
+    if (_segmentCount > 0) {
+      uint8_t i = 0;
+      while (i + 1 < _segmentCount && raw >= _segments[i + 1].raw) ++i;
+      const Segment& s = _segments[i];
+      const int32_t q7 =
+          s.q7 + ((static_cast<int32_t>(raw - s.raw) * s.slope +
+                   (static_cast<int32_t>(1) << (SlopeShift - 1))) >>
+                  SlopeShift);
+      return static_cast<int>((q7 + 64) >> 7);
+    }
+
+    const uint16_t offset = static_cast<uint16_t>(raw - _lo);
+    const uint8_t index = static_cast<uint8_t>(offset >> _shift);
+    const int32_t frac = offset & ((static_cast<uint16_t>(1) << _shift) - 1);
+    const int32_t a = _table[index];
+    const int32_t b = _table[index + 1];
+    const int32_t q7 = a + (((b - a) * frac) >> _shift);
+    return static_cast<int>((q7 + 64) >> 7);
+  }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef ARDUINOCOMMON_SENSORS_FILTEREDSENSOR_H
+#define ARDUINOCOMMON_SENSORS_FILTEREDSENSOR_H
+
+#include <Arduino.h>
+#include <ArduinoCommon/Sensors/AnalogSensor.h>
+#include <ArduinoCommon/Sensors/Filters.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Adds a compile-time filter pipeline in front of another sensor.
+ *
+ * Each update() takes exactly one reading from the wrapped sensor and
+ * feeds it through the stages in order. readRaw() and readPercent() then
+ * return the current filtered value without touching the ADC, so stable
+ * readings cost one conversion per update instead of a burst of samples.
+ *
+ * All filter state lives inside this object; there is no heap use.
+ *
+ * Typical usage:
+ * @code
+ * SoilSensor soil(A0);
+ * FilteredSensor<SoilSensor, Median<5>, Ema<32>> filtered(soil);
+ *
+ * void loop() {
+ *   filtered.update();
+ *   filtered.logPercent(Serial, "Soil");
+ * }
+ * @endcode
+ *
+ * @tparam Sensor Wrapped sensor type (any IAnalogSensor implementation).
+ * @tparam Stages Filter stages, applied left to right (see Filters.h).
+ */
+template <typename Sensor, typename... Stages>
+class FilteredSensor : public IAnalogSensor {
+ private:
+  Sensor& _sensor;
+  FilterChain<Stages...> _chain;
+  int _value = -1;
+
+ public:
+  /**
+   * @brief Wrap an existing sensor.
+   *
+   * @param sensor Non-owning reference; must outlive this object. The
+   *               wrapped sensor still needs its own begin() call.
+   */
+  explicit FilteredSensor(Sensor& sensor) : _sensor(sensor) {}
+
+  /**
+   * @brief Take one reading from the wrapped sensor and filter it.
+   *
+   * Failed reads (negative values) are skipped and leave the filter
+   * state untouched.
+   */
+  void update() override {
+    const int raw = _sensor.readRaw();
+    if (raw < 0) return;
+    _value = _chain.apply(raw);
+  }
+
+  /**
+   * @brief Take one reading and return the new filtered value.
+   */
+  int sample() {
+    update();
+    return _value;
+  }
+
+  /**
+   * @brief Discard all filter history.
+   */
+  void reset() {
+    _chain.reset();
+    _value = -1;
+  }
+
+  bool validConfiguration() const override {
+    return _sensor.validConfiguration();
+  }
+
+  /**
+   * @brief Current filtered raw value, or -1 before the first update().
+   */
+  int readRaw() const override { return _value; }
+
+  /**
+   * @brief Current filtered value mapped with the wrapped sensor's
+   * calibration, or -1 before the first update().
+   */
+  int readPercent() const override {
+    if (_value < 0) return -1;
+    return _sensor.rawToPercent(_value);
+  }
+
+  int rawToPercent(int raw) const override {
+    return _sensor.rawToPercent(raw);
+  }
+
+  bool isReady() const override { return _value >= 0; }
+
+  int sampledRaw() const override { return _value; }
+
+  /**
+   * @brief Access the wrapped sensor.
+   */
+  Sensor& sensor() { return _sensor; }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef ARDUINOCOMMON_SENSORS_FILTERS_H
+#define ARDUINOCOMMON_SENSORS_FILTERS_H
+
+#include <Arduino.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Incremental filter stages for raw sensor readings.
+ *
+ * Every stage keeps its history in fixed-size members (no heap) and
+ * exposes the same two functions:
+ *  - int apply(int sample): feed one sample, return the filtered value
+ *  - void reset():          forget all history
+ *
+ * Stages are chained with FilterChain and attached to a sensor with
+ * FilteredSensor.
+ */
+
+/**
+ * @brief Moving average over the last N samples.
+ *
+ * Keeps a running sum, so each sample costs O(1).
+ *
+ * @tparam N Window length (1..255).
+ */
+template <uint8_t N>
+class MovingAverage {
+  static_assert(N > 0, "MovingAverage: N must be > 0.");
+
+ private:
+  int16_t _window[N];
+  int32_t _sum = 0;
+  uint8_t _next = 0;
+  uint8_t _count = 0;
+
+ public:
+  int apply(int sample) {
+    if (_count == N) {
+      _sum -= _window[_next];
+    } else {
+      ++_count;
+    }
+    _window[_next] = static_cast<int16_t>(sample);
+    _sum += sample;
+    if (++_next == N) _next = 0;
+    return static_cast<int>(_sum / _count);
+  }
+
+  void reset() {
+    _sum = 0;
+    _next = 0;
+    _count = 0;
+  }
+};
+
+/**
+ * @brief Running median over the last N samples.
+ *
+ * Maintains the window both in arrival order and sorted. Each sample
+ * costs two binary searches (O(log N) comparisons) plus a short memmove,
+ * which for the small odd windows used for spike rejection (3–15) is
+ * cheaper than any heap-based structure.
+ *
+ * @tparam N Window length; must be odd so the median is a real sample.
+ */
+template <uint8_t N>
+class Median {
+  static_assert(N > 0 && (N % 2) == 1, "Median: N must be odd.");
+
+ private:
+  int16_t _window[N];  ///< Arrival order (ring).
+  int16_t _sorted[N];  ///< Same values, ascending.
+  uint8_t _next = 0;
+  uint8_t _count = 0;
+
+  /// First index in _sorted whose value is >= value.
+  uint8_t lowerBound(int16_t value) const {
+    uint8_t lo = 0;
+    uint8_t hi = _count;
+    while (lo < hi) {
+      const uint8_t mid = static_cast<uint8_t>((lo + hi) / 2);
+      if (_sorted[mid] < value) {
+        lo = static_cast<uint8_t>(mid + 1);
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+ public:
+  int apply(int sample) {
+    const int16_t value = static_cast<int16_t>(sample);
+
+    if (_count == N) {
+      const uint8_t old = lowerBound(_window[_next]);
+      memmove(&_sorted[old], &_sorted[old + 1],
+              (_count - old - 1) * sizeof(int16_t));
+      --_count;
+    }
+
+    const uint8_t pos = lowerBound(value);
+    memmove(&_sorted[pos + 1], &_sorted[pos],
+            (_count - pos) * sizeof(int16_t));
+    _sorted[pos] = value;
+    ++_count;
+
+    _window[_next] = value;
+    if (++_next == N) _next = 0;
+
+    return _sorted[_count / 2];
+  }
+
+  void reset() {
+    _next = 0;
+    _count = 0;
+  }
+};
+
+/**
+ * @brief Exponential moving average with a Q8 fixed-point smoothing factor.
+ *
+ * y += alpha * (x - y), where alpha = AlphaQ8 / 256. The state keeps
+ * 8 fractional bits so small steps are not lost to rounding. O(1) per
+ * sample, integer-only.
+ *
+ * @tparam AlphaQ8 Smoothing factor in [1,256]; 256 disables smoothing,
+ *                 smaller values smooth more (e.g. 32 ≈ 0.125).
+ */
+template <uint16_t AlphaQ8>
+class Ema {
+  static_assert(AlphaQ8 >= 1 && AlphaQ8 <= 256,
+                "Ema: AlphaQ8 must be in [1,256].");
+
+ private:
+  int32_t _state = 0;  ///< Filtered value, Q8.
+  bool _primed = false;
+
+ public:
+  int apply(int sample) {
+    const int32_t target = static_cast<int32_t>(sample) * 256;
+    if (!_primed) {
+      _state = target;
+      _primed = true;
+    } else {
+      _state += (target - _state) * static_cast<int32_t>(AlphaQ8) / 256;
+    }
+    return static_cast<int>((_state + 128) / 256);
+  }
+
+  void reset() { _primed = false; }
+};
+
+/**
+ * @brief One-dimensional Kalman filter for a slowly varying value.
+ *
+ * Treats the reading as a constant plus noise. Noise parameters are given
+ * in raw counts squared, scaled by 100 so they can be template arguments
+ * (e.g. MeasurementNoise100 = 400 means a variance of 4 counts²).
+ *
+ * @tparam ProcessNoise100     Expected drift variance per sample x100.
+ * @tparam MeasurementNoise100 ADC noise variance x100.
+ */
+template <uint32_t ProcessNoise100, uint32_t MeasurementNoise100>
+class Kalman {
+  static_assert(MeasurementNoise100 > 0,
+                "Kalman: MeasurementNoise100 must be > 0.");
+
+ private:
+  float _estimate = 0.0f;
+  float _errorVariance = 0.0f;
+  bool _primed = false;
+
+ public:
+  int apply(int sample) {
+    constexpr float q = ProcessNoise100 / 100.0f;
+    constexpr float r = MeasurementNoise100 / 100.0f;
+
+    if (!_primed) {
+      _estimate = static_cast<float>(sample);
+      _errorVariance = r;
+      _primed = true;
+    } else {
+      _errorVariance += q;
+      const float gain = _errorVariance / (_errorVariance + r);
+      _estimate += gain * (static_cast<float>(sample) - _estimate);
+      _errorVariance *= (1.0f - gain);
+    }
+    return static_cast<int>(_estimate + 0.5f);
+  }
+
+  void reset() { _primed = false; }
+};
+
+/**
+ * @brief Compile-time chain of filter stages, applied left to right.
+ */
+template <typename... Stages>
+class FilterChain;
+
+template <>
+class FilterChain<> {
+ public:
+  int apply(int sample) { return sample; }
+  void reset() {}
+};
+
+template <typename First, typename... Rest>
+class FilterChain<First, Rest...> {
+ private:
+  First _first;
+  FilterChain<Rest...> _rest;
+
+ public:
+  int apply(int sample) { return _rest.apply(_first.apply(sample)); }
+
+  void reset() {
+    _first.reset();
+    _rest.reset();
+  }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
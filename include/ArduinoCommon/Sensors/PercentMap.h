@@ -0,0 +1,77 @@
+#ifndef ARDUINOCOMMON_SENSORS_PERCENTMAP_H
+#define ARDUINOCOMMON_SENSORS_PERCENTMAP_H
+
+#include <Arduino.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Precomputed fixed-point raw→percent mapping.
+ *
+ * Produces exactly the same result as the clamped
+ * `map(raw, lo, hi, 100, 0)` used by SoilSensor::readPercent(), but the
+ * division is done once when the mapping is built. A conversion is then
+ * a clamp, one 32x32→64-bit multiply and a shift (a single UMULL on
+ * Cortex-M).
+ *
+ * Exactness: for a range R = hi - lo, the shift s is chosen so that
+ * 2^s >= R*R and the scale is ceil(100 * 2^s / R). The rounding error of
+ * the scale then stays below 1/R for every d in [0,R], which is less
+ * than the distance from any non-integer d*100/R to the next integer.
+ */
+struct PercentMap {
+  int16_t lo = 0;       ///< Lower raw bound (clamped).
+  int16_t hi = 0;       ///< Upper raw bound (clamped).
+  uint32_t scale = 0;   ///< Fixed-point multiplier.
+  uint8_t shift = 0;    ///< Right shift applied after multiplying.
+  bool valid = false;   ///< False until built from a non-degenerate range.
+
+  /**
+   * @brief Build a mapping from two calibration points.
+   *
+   * The points may be given in either order; the lower raw value maps to
+   * 100 % and the upper raw value to 0 %, as in SoilSensor::readPercent().
+   *
+   * @param dryRaw Raw reading when dry.
+   * @param wetRaw Raw reading when wet.
+   * @return PercentMap A valid mapping if both values are non-negative
+   *         and differ, otherwise an invalid (valid == false) mapping.
+   */
+  static PercentMap fromCalibration(int16_t dryRaw, int16_t wetRaw);
+
+  /**
+   * @brief Compute the fixed-point scale and shift for a range.
+   *
+   * Exposed so batch converters (e.g. SensorGroup) can store the
+   * parameters in their own arrays.
+   *
+   * @param range Positive raw span (hi - lo).
+   * @param scale Receives the multiplier.
+   * @param shift Receives the shift.
+   */
+  static void computeScale(uint16_t range, uint32_t& scale, uint8_t& shift);
+
+  /**
+   * @brief Floor of d * 100 / range using a precomputed scale and shift.
+   */
+  static uint8_t scaled(uint16_t d, uint32_t scale, uint8_t shift) {
+    return static_cast<uint8_t>((static_cast<uint64_t>(d) * scale) >> shift);
+  }
+
+  /**
+   * @brief Convert a raw reading to a percentage in [0,100].
+   *
+   * @pre valid is true.
+   */
+  int toPercent(int raw) const {
+    if (raw < lo) raw = lo;
+    if (raw > hi) raw = hi;
+    return 100 - scaled(static_cast<uint16_t>(raw - lo), scale, shift);
+  }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
@@ -4,37 +4,18 @@
 #include <Arduino.h>
 #include <ArduinoCommon/Utils/PinManager.h>
 #include <ArduinoCommon/Sensors/AnalogSensor.h>
+#include <ArduinoCommon/Sensors/AdcResolution.h>
+#include <ArduinoCommon/Sensors/AdcScanner.h>
+#include <ArduinoCommon/Sensors/AutoCalibrator.h>
+#include <ArduinoCommon/Sensors/CalibrationCurve.h>
+#include <ArduinoCommon/Sensors/PercentMap.h>
+#include <ArduinoCommon/Sensors/SoilCalibration.h>
+#include <ArduinoCommon/Config/ConfigRecord.h>
 #include <ArduinoCommon/Config/IConfigStorage.h>
 
 namespace ArduinoCommon {
 namespace Sensors {
 
-/**
- * @brief Calibration data for a soil moisture sensor.
- *
- * This struct stores the raw ADC values measured when the sensor is
- * completely dry and fully wet, along with a simple version field
- * for future extension.
- */
-struct SoilCalibration {
-  /// Raw reading when the sensor is in air / fully dry.
-  int16_t dryRaw = -1;
-  /// Raw reading when the sensor is fully wet (e.g., submerged in water).
-  int16_t wetRaw = -1;
-  /// Calibration data version (for potential future format changes).
-  uint8_t version = 1;
-
-  /**
-   * @brief Check whether the calibration values appear valid.
-   *
-   * @return true  If both dryRaw and wetRaw are non-negative and not equal.
-   * @return false If calibration is unset, invalid, or degenerate.
-   */
-  bool isValid() const {
-    return dryRaw >= 0 && wetRaw >= 0 && dryRaw != wetRaw;
-  }
-};
-
 /**
  * @brief Class for a capacitive soil moisture sensor.
  *
@@ -51,38 +32,156 @@ class SoilSensor : public IAnalogSensor {
   bool _validConfig;
 
   SoilCalibration _calibration;
+  // Fixed-point mapping derived from _calibration; see applyCalibration().
+  PercentMap _percentMap;
+  // Lookup table for multi-point curves; takes precedence when valid.
+  CalibrationLut _curveLut;
 
   // Optional non-owning pointer to a storage backend for calibration.
   Config::IConfigStorage* _storage;
   uint16_t _storageKey;
+  // Bytes reserved at _storageKey; see attachStorage().
+  uint16_t _slotSize;
+  // Set when attachStorage() rejected its slot; begin() then fails.
+  bool _storageError;
+  // Write unframed 6-byte records: the slot holds pre-record data whose
+  // neighbours may be packed right behind it.
+  bool _legacyFormat;
+
+  // Optional non-owning pointer to a background ADC scanner.
+  AdcScanner* _scanner;
+  int8_t _scanChannel;
+
+  // Oversampling: 4^_oversampleBits conversions per reading. update()
+  // accumulates them one per call in _decimateTotal.
+  uint8_t _oversampleBits;
+  uint16_t _decimateCount;
+  uint32_t _decimateTotal;
+
+  // Self-learning calibration and storage write throttling.
+  AutoCalibrator _autoCalibrator;
+  bool _autoCalibrating;
+  bool _hasPersisted;
+  uint32_t _lastPersistMs;
+  SoilCalibration _persisted;
+  // Dry/wet distance auto-calibration started from; narrower learned
+  // ranges are applied but never persisted.
+  int16_t _seededSpan;
+
+  // Threshold/deadband watches evaluated when a sampling run completes.
+  WatchList _watches;
+
+  // Non-blocking sampling state, driven by update().
+  uint8_t _sampleTarget;
+  uint8_t _sampleCount;
+  uint16_t _sampleIntervalMs;
+  uint32_t _lastSampleMs;
+  int32_t _sampleTotal;
+  int _sampledRaw;
+  bool _sampling;
+
+  /**
+   * @brief Replace the in-memory calibration and rebuild the percent map.
+   *
+   * All calibration changes go through here so the precomputed
+   * fixed-point mapping never goes stale.
+   */
+  void applyCalibration(const SoilCalibration& calibration);
+
+  /**
+   * @brief Take one raw ADC reading.
+   *
+   * Returns the scanner's latest conversion when a scanner is attached,
+   * otherwise performs a blocking analogRead().
+   */
+  int readAdc() const;
+
+  /**
+   * @brief Take one reading at the configured oversampling ratio.
+   *
+   * With oversampling disabled this is a single readAdc(). Blocks for
+   * all 4^extraBits conversions; update() uses takeSample() instead.
+   */
+  int readDecimated() const;
+
+  /**
+   * @brief Advance the reading in progress by at most one conversion.
+   *
+   * @param value Receives the reading once it is complete.
+   * @return true If @p value holds a complete (decimated) reading.
+   */
+  bool takeSample(int& value);
 
   /**
    * @brief Load calibration from the attached storage backend.
    *
-   * Attempts to read SoilCalibration data from the configured storage
-   * at the configured key. If successful and the data appears valid,
-   * it is applied to this sensor.
+   * Reads the CRC-protected calibration record at the configured key
+   * (a two-point SoilCalibration or a CalibrationCurve, told apart by
+   * the record version). Unframed SoilCalibration data written by older
+   * versions of this library is still accepted.
    *
    * @return true  If calibration data was loaded and is valid.
-   * @return false If no storage is attached, the read fails, or the
-   *               loaded calibration is invalid.
+   * @return false If no storage is attached, the slot is empty, the
+   *               record is corrupt (e.g. a torn write), or the loaded
+   *               calibration is invalid.
    */
   bool loadCalibrationFromStorage();
 
+  /**
+   * @brief Load an unframed (pre-record) SoilCalibration.
+   */
+  bool loadLegacyCalibration();
+
   /**
    * @brief Save the current calibration to the attached storage backend.
    *
    * If a storage backend has been attached and the calibration is valid,
-   * this writes the SoilCalibration struct to storage at the configured
-   * key.
+   * this writes the SoilCalibration struct as a CRC-protected record
+   * (see Config::ConfigRecord) at the configured key. A slot that holds
+   * unframed legacy data, or is smaller than StorageSize, is written in
+   * the legacy 6-byte format instead, so neighbouring data is kept.
    *
-   * @return true  If the write succeeds and storage is attached.
+   * Skips the write if the same calibration was already persisted.
+   *
+   * @return true  If the write succeeds (or was not needed) and storage
+   *               is attached.
    * @return false If no storage is attached, calibration is invalid,
    *               or the write fails.
    */
-  bool saveCalibrationToStorage() const;
+  bool saveCalibrationToStorage();
+
+  /**
+   * @brief Feed a completed reading to the auto-calibrator.
+   *
+   * Applies a changed calibration immediately, then calls
+   * persistLearnedCalibration().
+   */
+  void updateAutoCalibration(int raw);
+
+  /**
+   * @brief Persist the learned calibration if it is due.
+   *
+   * Checked after every completed run, not only when the calibration
+   * changes, so drift that built up within persistIntervalMs is still
+   * written once the interval is over. Writes only when the calibration
+   * drifted by more than persistThreshold from the stored copy,
+   * persistIntervalMs has passed since the last write, and the range is
+   * not narrower than the one auto-calibration started from.
+   */
+  void persistLearnedCalibration();
 
  public:
+  /// Record type of persisted calibration data ("SC").
+  static constexpr uint16_t CalibrationRecordType = 0x5343;
+
+  /// Storage bytes to reserve per sensor for a two-point calibration.
+  static constexpr uint16_t StorageSize =
+      Config::ConfigRecord::storedSize(sizeof(SoilCalibration));
+
+  /// Storage bytes to reserve for a sensor that persists a curve.
+  static constexpr uint16_t CurveStorageSize =
+      Config::ConfigRecord::storedSize(sizeof(CalibrationCurve));
+
   /**
    * @brief Construct a new SoilSensor object.
    *
@@ -104,12 +203,56 @@ class SoilSensor : public IAnalogSensor {
    *                The caller must ensure the lifetime exceeds that
    *                of this SoilSensor.
    * @param key     Byte offset or identifier within the storage backend
-   *                where the SoilCalibration struct will be stored.
+   *                where the calibration record will be stored. Slots
+   *                are not checked against each other at runtime; list
+   *                the sensors in a Config::ConfigLayout so the compiler
+   *                assigns non-overlapping keys.
+   * @param slotSize Bytes reserved at @p key. StorageSize holds a
+   *                two-point record; reserve CurveStorageSize (e.g.
+   *                ConfigBytes<SoilSensor::CurveStorageSize> in a
+   *                layout) to persist a calibration curve. A slot of
+   *                sizeof(SoilCalibration) bytes keeps the unframed
+   *                layout of library versions before records had a
+   *                header.
+   *
+   * @return true  If the slot was attached (or @p storage is nullptr,
+   *               which detaches).
+   * @return false If the slot is smaller than sizeof(SoilCalibration)
+   *               or would extend past the 16-bit key range. An error
+   *               is printed, the sensor is left without storage, and
+   *               begin() and validConfiguration() fail until a valid
+   *               slot (or nullptr) is attached, so an ignored result
+   *               cannot go unnoticed.
    *
    * @note If attachStorage() is never called, calibration will only
    *       exist in RAM for the lifetime of the SoilSensor instance.
+   * @note Earlier versions refused slots that overlapped another
+   *       sensor's. Sketches that relied on that should derive their
+   *       keys from a Config::ConfigLayout instead.
+   * @note Storage written by versions before framed records holds a
+   *       6-byte SoilCalibration per sensor, often packed back to back.
+   *       Such a slot is recognised on load and keeps being written in
+   *       that format, so saving never spills into a neighbour's data.
+   *       clearCalibration() does not change this; attach the sensors
+   *       at new keys to move to framed records.
    */
-  void attachStorage(Config::IConfigStorage* storage, uint16_t key);
+  bool attachStorage(Config::IConfigStorage* storage, uint16_t key,
+                     uint16_t slotSize = StorageSize);
+
+  /**
+   * @brief Read this sensor through a background AdcScanner.
+   *
+   * Registers the sensor's pin with the scanner. Afterwards readRaw()
+   * and the sampling functions return the scanner's most recent
+   * conversion from memory instead of calling analogRead(). Must be
+   * called before AdcScanner::begin().
+   *
+   * @param scanner Non-owning pointer to the scanner, or nullptr to go
+   *                back to direct analogRead() sampling.
+   * @return true  If the pin was registered (or scanner is nullptr).
+   * @return false If the scanner has no free channel or is running.
+   */
+  bool attachScanner(AdcScanner* scanner);
 
   /**
    * @brief Initialize the soil sensor.
@@ -146,6 +289,66 @@ class SoilSensor : public IAnalogSensor {
    */
   void setCalibration(int16_t dryRaw, int16_t wetRaw, bool persist = true);
 
+  /**
+   * @brief Learn the calibration from readings instead of setting it.
+   *
+   * Every completed sampling run (see startSampling()/update()) is fed to
+   * an AutoCalibrator, which tracks the observed dry/wet extremes with
+   * decay and outlier rejection and updates the mapping continuously.
+   * Storage writes are throttled by the config's persistThreshold and
+   * persistIntervalMs. An existing valid calibration is used as the
+   * starting point; a learned range narrower than it (e.g. after weeks
+   * of steady readings) is used but never written over the stored one.
+   *
+   * Auto-calibration only learns two points, so it cannot be combined
+   * with a calibration curve (see setCalibrationCurve()).
+   *
+   * @param config Tuning parameters. A negative maxValidRaw is replaced
+   *               with one below the sensor's full-scale value.
+   * @return true  If auto-calibration is now active.
+   * @return false If a calibration curve is active; call
+   *               setCalibration() or clearCalibration() first.
+   */
+  bool enableAutoCalibration(
+      const AutoCalibrationConfig& config = AutoCalibrationConfig());
+
+  /**
+   * @brief Stop learning; the current calibration is kept.
+   */
+  void disableAutoCalibration();
+
+  /**
+   * @brief Whether auto-calibration is active.
+   */
+  bool autoCalibrationEnabled() const;
+
+  /**
+   * @brief Use a multi-point or polynomial calibration curve.
+   *
+   * The curve is compiled into a lookup table, so readPercent() stays
+   * O(1). If persist is true and storage is attached, the full version 2
+   * record is written at the storage key; loadCalibrationFromStorage()
+   * recognises both this and the classic two-point (version 1) record.
+   * The record needs a slot of CurveStorageSize bytes (see
+   * attachStorage()); with a smaller slot an error is printed and the
+   * curve is only kept in RAM.
+   *
+   * setCalibration() replaces the curve with a two-point mapping again.
+   * Auto-calibration is turned off while a curve is active, so the
+   * curve is never silently replaced by a learned two-point mapping.
+   *
+   * @param curve   Curve to apply.
+   * @param persist If true, persist the curve to the attached storage.
+   * @return true  If the curve is valid and was applied.
+   * @return false If the curve is invalid.
+   */
+  bool setCalibrationCurve(const CalibrationCurve& curve, bool persist = true);
+
+  /**
+   * @brief Whether a multi-point curve (rather than two points) is active.
+   */
+  bool hasCalibrationCurve() const;
+
   /**
    * @brief Check whether a valid calibration has been set.
    *
@@ -158,10 +361,16 @@ class SoilSensor : public IAnalogSensor {
    * @brief Clear the current calibration.
    *
    * Resets the in-memory calibration to default values and, if a
-   * storage backend is attached, clears the stored calibration there
-   * as well (implementation-dependent).
+   * storage backend is attached, erases the stored record there as
+   * well. The record header is erased first, so an interrupted clear
+   * leaves an empty slot rather than a partial record. Only the bytes
+   * the record occupies are cleared (never more than the slot), so
+   * a storage smaller than the slot is not accessed out of range.
+   *
+   * @return true  If the record was erased, or no storage is attached.
+   * @return false If the storage rejected the access.
    */
-  void clearCalibration();
+  bool clearCalibration();
 
   /**
    * @brief Check whether the sensor configuration is valid.
@@ -182,14 +391,58 @@ class SoilSensor : public IAnalogSensor {
    */
   SoilCalibration getCalibration() const;
 
+  /**
+   * @brief Enable oversampling and decimation.
+   *
+   * Each reading accumulates 4^extraBits conversions and returns the sum
+   * shifted right by extraBits, so readings span resolutionBits() bits.
+   * The total (ADC bits + extraBits) is limited to 15 so values still fit
+   * SoilCalibration's int16_t fields.
+   *
+   * startSampling()/update() keep to one conversion per update() call,
+   * so with oversampling each sample takes 4^extraBits update() calls;
+   * only readRaw() and readAveragedRaw() block for all of them.
+   *
+   * When an AdcScanner is attached, the scanner's single conversion is
+   * only shifted left by extraBits: readings use the same units as with
+   * oversampling, but gain no resolution. Oversample in the scanner's
+   * backend instead if the extra bits matter.
+   *
+   * @param extraBits          Additional bits (0 disables).
+   * @param rescaleCalibration If true, the current calibration is shifted
+   *                           to the new range (not persisted).
+   * @return true  If the mode was applied.
+   * @return false If the requested resolution is too wide, or a
+   *               calibration curve is active and would need rescaling.
+   */
+  bool setOversampling(uint8_t extraBits, bool rescaleCalibration);
+
+  bool setOversampling(uint8_t extraBits) override {
+    return setOversampling(extraBits, true);
+  }
+
+  /**
+   * @brief Additional bits currently gained by oversampling.
+   */
+  uint8_t oversamplingBits() const;
+
+  /**
+   * @brief Effective resolution: AdcResolution::bits() + oversampling.
+   */
+  uint8_t resolutionBits() const override;
+
   /**
    * @brief Read a raw value from the soil moisture sensor.
    *
    * The exact range depends on the underlying hardware and ADC
    * (e.g., 0–1023 on AVR-based Arduinos, 0–4095 on some 12-bit ADCs).
+   * When an AdcScanner is attached, this returns its latest conversion
+   * without touching the ADC. With oversampling enabled the value spans
+   * resolutionBits() bits.
    *
    * @return int A non-negative raw reading on success; a negative value
-   *             if the sensor is not configured or cannot be read.
+   *             if the sensor is not configured or cannot be read (or the
+   *             attached scanner has not produced a value yet).
    */
   int readRaw() const override;
 
@@ -200,6 +453,7 @@ class SoilSensor : public IAnalogSensor {
    * sensor reading into a percentage in the range [0,100]. If
    * wetRaw < dryRaw (common for some capacitive sensors), the mapping
    * accounts for this inverted range. The result is clamped to [0,100].
+   * Without a calibration, the full resolutionBits() range is mapped.
    *
    * @return int A percentage in the range [0,100] on success, or a
    *             negative value if the sensor is not configured or
@@ -207,6 +461,14 @@ class SoilSensor : public IAnalogSensor {
    */
   int readPercent() const override;
 
+  /**
+   * @brief Convert a raw reading into a percentage using the calibration.
+   *
+   * @param raw Raw ADC reading.
+   * @return int A percentage in the range [0,100] when calibrated.
+   */
+  int rawToPercent(int raw) const override;
+
   /**
    * @brief Read multiple raw samples and return their average.
    *
@@ -217,8 +479,81 @@ class SoilSensor : public IAnalogSensor {
    * @param samples Number of samples to read, defaults to 10.
    * @return int A non-negative averaged reading on success; a negative
    *             value if configuration is invalid or reads fail.
+   *
+   * @warning This call blocks for roughly 10 ms per sample. Prefer
+   *          startSampling()/update() in a loop that must stay responsive.
    */
   int readAveragedRaw(uint8_t samples = 10) const;
+
+  /**
+   * @brief Start a non-blocking averaged sampling run.
+   *
+   * The first sample is taken on the next update() call; subsequent
+   * samples are taken once at least @p intervalMs has elapsed (based on
+   * millis()). Starting a new run discards any run in progress.
+   *
+   * @param samples    Number of samples to average (must be > 0).
+   * @param intervalMs Minimum time between consecutive samples.
+   * @return true  If sampling was started.
+   * @return false If the sensor is not configured or samples is 0.
+   */
+  bool startSampling(uint8_t samples = 10, uint16_t intervalMs = 10) override;
+
+  /**
+   * @brief Advance the sampling state machine by at most one conversion.
+   *
+   * Safe to call on every loop() iteration; returns immediately if no
+   * run is active or the next sample is not due yet. With oversampling
+   * (see setOversampling()) a sample is complete after 4^extraBits
+   * calls, taken back to back.
+   */
+  void update() override;
+
+  /**
+   * @brief Check whether a sampling run is currently in progress.
+   */
+  bool isSampling() const;
+
+  /**
+   * @brief Check whether the last sampling run has completed.
+   */
+  bool isReady() const override;
+
+  /**
+   * @brief Get the averaged raw value of the last completed run.
+   *
+   * @return int The averaged reading, or -1 if no run has completed.
+   */
+  int sampledRaw() const override;
+
+  /**
+   * @brief Watch for a completed reading crossing a threshold.
+   *
+   * Evaluated at the end of every sampling run driven by update(), so
+   * the loop only needs to react in the callback.
+   */
+  int8_t addThresholdWatch(WatchSource source, int16_t threshold,
+                           int16_t hysteresis, WatchCallback callback,
+                           void* context = nullptr) override;
+
+  /**
+   * @brief Watch for a completed reading moving by more than a deadband.
+   */
+  int8_t addDeadbandWatch(WatchSource source, int16_t deadband,
+                          WatchCallback callback,
+                          void* context = nullptr) override;
+
+  bool removeWatch(int8_t id) override;
+
+  /**
+   * @brief Get the last completed run's average as a percentage.
+   *
+   * Uses the same mapping as readPercent() without touching the ADC.
+   *
+   * @return int A percentage in the range [0,100], or -1 if no run has
+   *             completed.
+   */
+  int sampledPercent() const;
 };
 
 }  // namespace Sensors
@@ -0,0 +1,233 @@
+#ifndef ARDUINOCOMMON_SENSORS_SENSORGROUP_H
+#define ARDUINOCOMMON_SENSORS_SENSORGROUP_H
+
+#include <Arduino.h>
+#include <ArduinoCommon/Utils/PinManager.h>
+#include <ArduinoCommon/Sensors/AdcScanner.h>
+#include <ArduinoCommon/Sensors/PercentMap.h>
+#include <ArduinoCommon/Sensors/SOILSENSOR.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Batch reader for many analog moisture probes.
+ *
+ * Instead of one object per probe, a SensorGroup keeps pins, calibration
+ * and the last readings in parallel fixed-size arrays (struct-of-arrays).
+ * Configuration is validated once in add(); after that, readAll() reads
+ * every channel in a single pass and computePercents() converts all of
+ * them in one branch-free loop, with no virtual calls per sample and no
+ * division (see PercentMap).
+ *
+ * Percentages follow the same mapping as SoilSensor::readPercent().
+ *
+ * Typical usage:
+ * @code
+ * SensorGroup<16> probes;
+ * probes.add(A0, 500, 200);
+ * probes.add(A1, 550, 250);
+ *
+ * void loop() {
+ *   probes.update();
+ *   for (uint8_t i = 0; i < probes.count(); ++i) {
+ *     Serial.println(probes.percent(i));
+ *   }
+ * }
+ * @endcode
+ *
+ * @tparam Capacity Maximum number of channels in the group.
+ */
+template <uint8_t Capacity>
+class SensorGroup {
+  static_assert(Capacity > 0, "SensorGroup: Capacity must be > 0.");
+
+ private:
+  static constexpr int16_t DefaultMaxRaw = 1023;
+
+  uint8_t _count = 0;
+  AdcScanner* _scanner = nullptr;
+
+  // Configuration, one entry per channel.
+  uint8_t _pins[Capacity];
+  int8_t _scanChannels[Capacity];
+  int16_t _lo[Capacity];      ///< Lower raw bound of the mapping.
+  int16_t _hi[Capacity];      ///< Upper raw bound of the mapping.
+  uint32_t _scale[Capacity];  ///< Fixed-point 100 / (_hi - _lo).
+  uint8_t _shift[Capacity];   ///< Shift paired with _scale.
+  int16_t _base[Capacity];    ///< Percent at _lo (100, or 0 if uncalibrated).
+  int8_t _direction[Capacity];  ///< -1 if calibrated, +1 if uncalibrated.
+
+  // Last readings, one entry per channel.
+  int16_t _raw[Capacity];
+  int16_t _percent[Capacity];
+
+  void applyCalibration(uint8_t index, int16_t dryRaw, int16_t wetRaw) {
+    SoilCalibration cal;
+    cal.dryRaw = dryRaw;
+    cal.wetRaw = wetRaw;
+
+    if (cal.isValid()) {
+      _lo[index] = min(dryRaw, wetRaw);
+      _hi[index] = max(dryRaw, wetRaw);
+      _base[index] = 100;
+      _direction[index] = -1;
+    } else {
+      _lo[index] = 0;
+      _hi[index] = DefaultMaxRaw;
+      _base[index] = 0;
+      _direction[index] = 1;
+    }
+    PercentMap::computeScale(static_cast<uint16_t>(_hi[index] - _lo[index]),
+                             _scale[index], _shift[index]);
+  }
+
+ public:
+  SensorGroup() = default;
+  SensorGroup(const SensorGroup&) = delete;
+  SensorGroup& operator=(const SensorGroup&) = delete;
+
+  /**
+   * @brief Release all pins reserved by this group.
+   */
+  ~SensorGroup() {
+    for (uint8_t i = 0; i < _count; ++i) {
+      Utils::PinManager::releasePin(_pins[i]);
+    }
+  }
+
+  /**
+   * @brief Add a probe to the group.
+   *
+   * Reserves and configures the pin as an input. If dry/wet calibration
+   * values are omitted or invalid, the channel maps the 10-bit range
+   * 0–1023 to 0–100 % like an uncalibrated SoilSensor.
+   *
+   * @param pin    Analog input pin.
+   * @param dryRaw Raw reading when the probe is dry.
+   * @param wetRaw Raw reading when the probe is fully wet.
+   * @return int The channel index, or -1 if the group is full or the pin
+   *             could not be reserved.
+   */
+  int add(uint8_t pin, int16_t dryRaw = -1, int16_t wetRaw = -1) {
+    if (_count >= Capacity) return -1;
+    if (!Utils::PinManager::reservePin(pin)) return -1;
+    pinMode(pin, INPUT);
+
+    const uint8_t index = _count;
+    _pins[index] = pin;
+    _scanChannels[index] = -1;
+    _raw[index] = -1;
+    _percent[index] = -1;
+    applyCalibration(index, dryRaw, wetRaw);
+    return _count++;
+  }
+
+  /**
+   * @brief Add a probe using an existing calibration record.
+   */
+  int add(uint8_t pin, const SoilCalibration& calibration) {
+    return add(pin, calibration.dryRaw, calibration.wetRaw);
+  }
+
+  /**
+   * @brief Replace the calibration of a channel.
+   *
+   * @return true If @p index refers to an existing channel.
+   */
+  bool setCalibration(uint8_t index, int16_t dryRaw, int16_t wetRaw) {
+    if (index >= _count) return false;
+    applyCalibration(index, dryRaw, wetRaw);
+    return true;
+  }
+
+  /**
+   * @brief Read channels from a background AdcScanner instead of
+   * calling analogRead() for each one.
+   *
+   * Registers every channel's pin with the scanner; call after all add()
+   * calls and before AdcScanner::begin().
+   *
+   * @return true If every channel was registered.
+   */
+  bool attachScanner(AdcScanner* scanner) {
+    _scanner = scanner;
+    bool ok = true;
+    for (uint8_t i = 0; i < _count; ++i) {
+      const int channel = scanner ? scanner->addChannel(_pins[i]) : -1;
+      _scanChannels[i] = static_cast<int8_t>(channel);
+      if (scanner && channel < 0) ok = false;
+    }
+    return ok;
+  }
+
+  /**
+   * @brief Read the raw value of every channel in one pass.
+   *
+   * Channels without a value yet (scanner not converted) read as -1.
+   */
+  void readAll() {
+    if (_scanner) {
+      for (uint8_t i = 0; i < _count; ++i) {
+        _raw[i] = static_cast<int16_t>(_scanner->latest(_scanChannels[i]));
+      }
+    } else {
+      for (uint8_t i = 0; i < _count; ++i) {
+        _raw[i] = static_cast<int16_t>(analogRead(_pins[i]));
+      }
+    }
+  }
+
+  /**
+   * @brief Convert all last raw readings into percentages.
+   *
+   * The loop body has no data-dependent branches, so the compiler can
+   * unroll or vectorize it. Channels with a negative raw value report 0,
+   * matching SoilSensor::readPercent().
+   */
+  void computePercents() {
+    for (uint8_t i = 0; i < _count; ++i) {
+      const int32_t raw = _raw[i];
+      const int32_t clamped = constrain(raw, _lo[i], _hi[i]);
+      const int32_t scaled = PercentMap::scaled(
+          static_cast<uint16_t>(clamped - _lo[i]), _scale[i], _shift[i]);
+      const int32_t percent = _base[i] + _direction[i] * scaled;
+      _percent[i] = raw < 0 ? 0 : static_cast<int16_t>(percent);
+    }
+  }
+
+  /**
+   * @brief Convenience for readAll() followed by computePercents().
+   */
+  void update() {
+    readAll();
+    computePercents();
+  }
+
+  /// Number of channels in the group.
+  uint8_t count() const { return _count; }
+
+  /// Pin of a channel, or 0xFF if @p index is out of range.
+  uint8_t pin(uint8_t index) const {
+    return index < _count ? _pins[index] : 0xFF;
+  }
+
+  /// Last raw reading of a channel, or -1 if unavailable.
+  int raw(uint8_t index) const { return index < _count ? _raw[index] : -1; }
+
+  /// Last computed percentage of a channel, or -1 if unavailable.
+  int percent(uint8_t index) const {
+    return index < _count ? _percent[index] : -1;
+  }
+
+  /// Contiguous array of the last raw readings (count() entries).
+  const int16_t* rawData() const { return _raw; }
+
+  /// Contiguous array of the last percentages (count() entries).
+  const int16_t* percentData() const { return _percent; }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef ARDUINOCOMMON_SENSORS_SENSORHISTORY_H
+#define ARDUINOCOMMON_SENSORS_SENSORHISTORY_H
+
+#include <Arduino.h>
+#include <math.h>
+#include <ArduinoCommon/Sensors/AnalogSensor.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief One timestamped reading stored in a SensorHistory.
+ */
+struct TimedSample {
+  uint32_t timeMs;  ///< millis() when the sample was recorded.
+  int16_t value;    ///< Raw (or percent) reading.
+};
+
+/**
+ * @brief Fixed-capacity, timestamped sample history with running statistics.
+ *
+ * Keeps the last @p Capacity samples, optionally limited to a time window
+ * (e.g. the last 30 minutes). Aggregates are maintained as samples enter
+ * and leave the window, so count(), mean(), variance(), minimum() and
+ * maximum() are O(1) queries:
+ *
+ *  - mean/variance from exact integer running sums (sum and sum of
+ *    squares), which, unlike a floating-point Welford update, do not
+ *    drift when samples are removed again;
+ *  - minimum/maximum from monotonic deques (amortized O(1) per sample).
+ *
+ * Memory use is fixed at compile time: per slot, sizeof(TimedSample)
+ * plus 2 bytes each for the min and max deques, plus a few counters.
+ * TimedSample is 6 bytes on AVR but padded to 8 where uint32_t is
+ * 4-byte aligned (ARM, ESP32), so a slot takes 10 or 12 bytes;
+ * sizeof(SensorHistory<N>) gives the exact figure.
+ *
+ * Typical usage:
+ * @code
+ * SensorHistory<64> history(30UL * 60UL * 1000UL);  // last 30 minutes
+ *
+ * void loop() {
+ *   history.record(soil);               // one readRaw() per call
+ *   if (history.mean() > 450) { ... }   // no re-reading, no recompute
+ * }
+ * @endcode
+ *
+ * @tparam Capacity Maximum number of samples; a power of two <= 4096.
+ */
+template <uint16_t Capacity>
+class SensorHistory {
+  static_assert(Capacity >= 2 && Capacity <= 4096,
+                "SensorHistory: Capacity must be in [2,4096].");
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "SensorHistory: Capacity must be a power of two.");
+
+ private:
+  static constexpr uint16_t Mask = Capacity - 1;
+
+  /**
+   * @brief Deque of sample sequence numbers with monotonic values.
+   */
+  struct MonotonicDeque {
+    uint16_t seqs[Capacity];
+    uint16_t front = 0;  ///< Position of the first entry (wraps).
+    uint16_t back = 0;   ///< Position after the last entry (wraps).
+
+    bool empty() const { return front == back; }
+    uint16_t first() const { return seqs[front & Mask]; }
+    uint16_t last() const { return seqs[static_cast<uint16_t>(back - 1) & Mask]; }
+    void pushBack(uint16_t seq) { seqs[back++ & Mask] = seq; }
+    void popBack() { --back; }
+    void popFront() { ++front; }
+    void clear() { front = back = 0; }
+  };
+
+  TimedSample _samples[Capacity];
+  MonotonicDeque _minDeque;  ///< Values ascending from front.
+  MonotonicDeque _maxDeque;  ///< Values descending from front.
+
+  uint32_t _windowMs;
+  uint16_t _head = 0;   ///< Sequence number of the next sample (wraps).
+  uint16_t _count = 0;
+  int32_t _sum = 0;
+  uint64_t _sumSquares = 0;
+
+  const TimedSample& sampleAt(uint16_t seq) const {
+    return _samples[seq & Mask];
+  }
+
+  uint16_t oldestSeq() const { return static_cast<uint16_t>(_head - _count); }
+
+  void evictOldest() {
+    const uint16_t seq = oldestSeq();
+    const int32_t value = sampleAt(seq).value;
+
+    _sum -= value;
+    _sumSquares -= static_cast<uint64_t>(value * value);
+    --_count;
+
+    if (!_minDeque.empty() && _minDeque.first() == seq) _minDeque.popFront();
+    if (!_maxDeque.empty() && _maxDeque.first() == seq) _maxDeque.popFront();
+  }
+
+ public:
+  /**
+   * @brief Create an empty history.
+   *
+   * @param windowMs Maximum age of samples in milliseconds; 0 keeps the
+   *                 last Capacity samples regardless of age.
+   */
+  explicit SensorHistory(uint32_t windowMs = 0) : _windowMs(windowMs) {}
+
+  /**
+   * @brief Add a sample, evicting samples that fall out of the window.
+   *
+   * @param value  Reading to store.
+   * @param timeMs Timestamp of the reading (defaults to millis()).
+   */
+  void push(int16_t value, uint32_t timeMs) {
+    expire(timeMs);
+    if (_count == Capacity) evictOldest();
+
+    const uint16_t seq = _head++;
+    _samples[seq & Mask] = TimedSample{timeMs, value};
+    ++_count;
+    _sum += value;
+    _sumSquares += static_cast<uint64_t>(static_cast<int32_t>(value) * value);
+
+    while (!_minDeque.empty() && sampleAt(_minDeque.last()).value >= value) {
+      _minDeque.popBack();
+    }
+    _minDeque.pushBack(seq);
+
+    while (!_maxDeque.empty() && sampleAt(_maxDeque.last()).value <= value) {
+      _maxDeque.popBack();
+    }
+    _maxDeque.pushBack(seq);
+  }
+
+  void push(int16_t value) { push(value, millis()); }
+
+  /**
+   * @brief Read the sensor once and record the result.
+   *
+   * @return true If the sensor produced a valid (non-negative) reading.
+   */
+  bool record(const IAnalogSensor& sensor, uint32_t timeMs) {
+    if (!sensor.validConfiguration()) return false;
+
+    const int value = sensor.readRaw();
+    if (value < 0) return false;
+
+    push(static_cast<int16_t>(value), timeMs);
+    return true;
+  }
+
+  bool record(const IAnalogSensor& sensor) { return record(sensor, millis()); }
+
+  /**
+   * @brief Drop samples older than the time window.
+   *
+   * Called automatically by push(); call it before querying if samples
+   * may have aged out since the last push.
+   *
+   * @param nowMs Current time (defaults to millis()).
+   */
+  void expire(uint32_t nowMs) {
+    if (_windowMs == 0) return;
+    while (_count > 0 &&
+           static_cast<uint32_t>(nowMs - sampleAt(oldestSeq()).timeMs) >
+               _windowMs) {
+      evictOldest();
+    }
+  }
+
+  void expire() { expire(millis()); }
+
+  /**
+   * @brief Remove all samples.
+   */
+  void clear() {
+    _count = 0;
+    _sum = 0;
+    _sumSquares = 0;
+    _minDeque.clear();
+    _maxDeque.clear();
+  }
+
+  /// Number of samples currently in the window.
+  uint16_t count() const { return _count; }
+
+  /// Maximum number of samples.
+  static constexpr uint16_t capacity() { return Capacity; }
+
+  /// Time window in milliseconds (0 = unlimited).
+  uint32_t windowMs() const { return _windowMs; }
+
+  /// Arithmetic mean, or 0 if empty.
+  float mean() const {
+    return _count ? static_cast<float>(_sum) / _count : 0.0f;
+  }
+
+  /// Sample variance (n - 1 denominator), or 0 with fewer than 2 samples.
+  float variance() const {
+    if (_count < 2) return 0.0f;
+    const int64_t n = _count;
+    const int64_t numerator =
+        n * static_cast<int64_t>(_sumSquares) -
+        static_cast<int64_t>(_sum) * static_cast<int64_t>(_sum);
+    return static_cast<float>(numerator) / static_cast<float>(n * (n - 1));
+  }
+
+  /// Sample standard deviation.
+  float stddev() const { return sqrtf(variance()); }
+
+  /// Smallest value in the window, or -1 if empty.
+  int minimum() const {
+    return _minDeque.empty() ? -1 : sampleAt(_minDeque.first()).value;
+  }
+
+  /// Largest value in the window, or -1 if empty.
+  int maximum() const {
+    return _maxDeque.empty() ? -1 : sampleAt(_maxDeque.first()).value;
+  }
+
+  /**
+   * @brief Access a sample by age.
+   *
+   * @param index 0 is the oldest sample, count() - 1 the newest.
+   * @pre index < count()
+   */
+  const TimedSample& at(uint16_t index) const {
+    return sampleAt(static_cast<uint16_t>(oldestSeq() + index));
+  }
+
+  /// Most recent sample. @pre count() > 0
+  const TimedSample& newest() const {
+    return sampleAt(static_cast<uint16_t>(_head - 1));
+  }
+
+  /// Oldest sample still in the window. @pre count() > 0
+  const TimedSample& oldest() const { return sampleAt(oldestSeq()); }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef ARDUINOCOMMON_SENSORS_SENSORWATCH_H
+#define ARDUINOCOMMON_SENSORS_SENSORWATCH_H
+
+#include <Arduino.h>
+
+#ifndef ARDUINOCOMMON_MAX_SENSOR_WATCHES
+#define ARDUINOCOMMON_MAX_SENSOR_WATCHES 4
+#endif
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+class IAnalogSensor;
+
+/**
+ * @brief Which reading a watch is evaluated against.
+ */
+enum class WatchSource : uint8_t {
+  Raw = 0,  ///< Raw (averaged) ADC value.
+  Percent,  ///< Calibrated percentage.
+};
+
+/**
+ * @brief Why a watch callback fired.
+ */
+enum class WatchEvent : uint8_t {
+  Below = 0,  ///< Value dropped below a threshold.
+  Above,      ///< Value rose back above threshold + hysteresis.
+  Changed,    ///< Value moved by more than the deadband.
+};
+
+/**
+ * @brief Details passed to a watch callback.
+ */
+struct SensorEvent {
+  WatchEvent type;  ///< What happened.
+  int8_t watchId;   ///< Id returned when the watch was registered.
+  int16_t value;    ///< Reading that triggered the event.
+};
+
+/**
+ * @brief Watch callback.
+ *
+ * @param sensor  Sensor whose reading triggered the event.
+ * @param event   Event details.
+ * @param context User pointer given at registration.
+ */
+using WatchCallback = void (*)(IAnalogSensor& sensor, const SensorEvent& event,
+                               void* context);
+
+/**
+ * @brief Fixed-size set of threshold and deadband watches.
+ *
+ * Sensors own a WatchList and call evaluate() whenever a new reading
+ * completes. Callbacks fire only on state changes, so the application
+ * does work only when something actually happened.
+ *
+ * - Threshold watch: fires Below once the value drops under
+ *   @p threshold, and Above once it climbs back to
+ *   threshold + hysteresis or more. The first reading establishes the
+ *   state and fires the matching event.
+ * - Deadband watch: fires Changed on the first reading and then whenever
+ *   the value differs from the last reported value by more than
+ *   @p deadband.
+ */
+class WatchList {
+ public:
+  /// Maximum number of watches per list.
+  static constexpr uint8_t MaxWatches = ARDUINOCOMMON_MAX_SENSOR_WATCHES;
+
+ private:
+  enum class Kind : uint8_t { Unused = 0, Threshold, Deadband };
+  enum class State : uint8_t { Unknown = 0, Below, Above };
+
+  struct Watch {
+    Kind kind = Kind::Unused;
+    WatchSource source = WatchSource::Raw;
+    State state = State::Unknown;
+    int16_t limit = 0;   ///< Threshold, or deadband width.
+    int16_t margin = 0;  ///< Hysteresis (threshold watches).
+    int16_t last = 0;    ///< Last reported value (deadband watches).
+    WatchCallback callback = nullptr;
+    void* context = nullptr;
+  };
+
+  Watch _watches[MaxWatches];
+
+  int8_t add(Kind kind, WatchSource source, int16_t limit, int16_t margin,
+             WatchCallback callback, void* context);
+
+ public:
+  /**
+   * @brief Register a threshold watch with hysteresis.
+   *
+   * @return int8_t Watch id, or -1 if the list is full or callback is null.
+   */
+  int8_t addThreshold(WatchSource source, int16_t threshold,
+                      int16_t hysteresis, WatchCallback callback,
+                      void* context = nullptr);
+
+  /**
+   * @brief Register a deadband (change) watch.
+   *
+   * @return int8_t Watch id, or -1 if the list is full or callback is null.
+   */
+  int8_t addDeadband(WatchSource source, int16_t deadband,
+                     WatchCallback callback, void* context = nullptr);
+
+  /**
+   * @brief Remove a watch by id.
+   *
+   * @return true If the id referred to a registered watch.
+   */
+  bool remove(int8_t id);
+
+  /**
+   * @brief Remove all watches.
+   */
+  void clear();
+
+  /**
+   * @brief Check whether any watch is registered.
+   */
+  bool empty() const;
+
+  /**
+   * @brief Check all watches against a new reading.
+   *
+   * @param sensor  Sensor passed to callbacks.
+   * @param raw     New raw reading.
+   * @param percent New percentage (negative if unavailable; percent
+   *                watches are then skipped).
+   */
+  void evaluate(IAnalogSensor& sensor, int raw, int percent);
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
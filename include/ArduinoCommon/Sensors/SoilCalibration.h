@@ -0,0 +1,38 @@
+#ifndef ARDUINOCOMMON_SENSORS_SOILCALIBRATION_H
+#define ARDUINOCOMMON_SENSORS_SOILCALIBRATION_H
+
+#include <Arduino.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Calibration data for a soil moisture sensor.
+ *
+ * This struct stores the raw ADC values measured when the sensor is
+ * completely dry and fully wet, along with a simple version field
+ * for future extension.
+ */
+struct SoilCalibration {
+  /// Raw reading when the sensor is in air / fully dry.
+  int16_t dryRaw = -1;
+  /// Raw reading when the sensor is fully wet (e.g., submerged in water).
+  int16_t wetRaw = -1;
+  /// Calibration data version (for potential future format changes).
+  uint8_t version = 1;
+
+  /**
+   * @brief Check whether the calibration values appear valid.
+   *
+   * @return true  If both dryRaw and wetRaw are non-negative and not equal.
+   * @return false If calibration is unset, invalid, or degenerate.
+   */
+  bool isValid() const {
+    return dryRaw >= 0 && wetRaw >= 0 && dryRaw != wetRaw;
+  }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
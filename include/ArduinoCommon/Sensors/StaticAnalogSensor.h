@@ -0,0 +1,114 @@
+#ifndef ARDUINOCOMMON_SENSORS_STATICANALOGSENSOR_H
+#define ARDUINOCOMMON_SENSORS_STATICANALOGSENSOR_H
+
+#include <Arduino.h>
+#include <ArduinoCommon/Sensors/AnalogSensor.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Compile-time (CRTP) counterpart of IAnalogSensor.
+ *
+ * Provides the same API as IAnalogSensor — validConfiguration(),
+ * readRaw(), readPercent(), rawToPercent(), logRaw() and logPercent() —
+ * but dispatches statically to the derived class. There is no vtable and
+ * every call can be inlined, which suits fixed sensor sets that are known
+ * at compile time.
+ *
+ * A derived class must provide:
+ *  - bool validConfiguration() const
+ *  - int readRaw() const
+ * and may provide readPercent() and rawToPercent() to hide the defaults.
+ *
+ * Use VirtualAnalogSensor to place a static sensor into a heterogeneous
+ * IAnalogSensor collection.
+ *
+ * @code
+ * class MySensor : public StaticAnalogSensor<MySensor> {
+ *  public:
+ *   bool validConfiguration() const { return true; }
+ *   int readRaw() const { return analogRead(A0); }
+ * };
+ * @endcode
+ *
+ * @tparam Derived The implementing class.
+ */
+template <typename Derived>
+class StaticAnalogSensor {
+ protected:
+  StaticAnalogSensor() = default;
+  ~StaticAnalogSensor() = default;
+
+ private:
+  const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+ public:
+  /**
+   * @brief Default percentage reading: not supported (-1).
+   */
+  int readPercent() const { return -1; }
+
+  /**
+   * @brief Default raw→percent conversion: not supported (-1).
+   */
+  int rawToPercent(int /*raw*/) const { return -1; }
+
+  /**
+   * @brief Log a raw reading; same output as IAnalogSensor::logRaw().
+   */
+  void logRaw(Stream& out, const char* label = nullptr) const {
+    if (!derived().validConfiguration()) return;
+
+    const int value = derived().readRaw();
+    if (value < 0) return;
+
+    printReading(out, label, F("Raw: "), value);
+  }
+
+  /**
+   * @brief Log a percentage; same output as IAnalogSensor::logPercent().
+   */
+  void logPercent(Stream& out, const char* label = nullptr) const {
+    if (!derived().validConfiguration()) return;
+
+    const int value = derived().readPercent();
+    if (value < 0) return;
+
+    printReading(out, label, F("Percent: "), value, F("%"));
+  }
+};
+
+/**
+ * @brief Adapter exposing a static sensor through IAnalogSensor.
+ *
+ * Only the adapter carries a vtable; the wrapped sensor stays
+ * non-polymorphic and can still be used directly in hot loops.
+ *
+ * @tparam Sensor A StaticAnalogSensor-derived type.
+ */
+template <typename Sensor>
+class VirtualAnalogSensor : public IAnalogSensor {
+ private:
+  const Sensor& _sensor;
+
+ public:
+  /**
+   * @param sensor Non-owning reference; must outlive the adapter.
+   */
+  explicit VirtualAnalogSensor(const Sensor& sensor) : _sensor(sensor) {}
+
+  bool validConfiguration() const override {
+    return _sensor.validConfiguration();
+  }
+  int readRaw() const override { return _sensor.readRaw(); }
+  int readPercent() const override { return _sensor.readPercent(); }
+  int rawToPercent(int raw) const override {
+    return _sensor.rawToPercent(raw);
+  }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
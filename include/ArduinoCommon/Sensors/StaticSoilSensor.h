@@ -0,0 +1,82 @@
+#ifndef ARDUINOCOMMON_SENSORS_STATICSOILSENSOR_H
+#define ARDUINOCOMMON_SENSORS_STATICSOILSENSOR_H
+
+#include <Arduino.h>
+#include <ArduinoCommon/Sensors/AdcResolution.h>
+#include <ArduinoCommon/Sensors/PercentMap.h>
+#include <ArduinoCommon/Sensors/SOILSENSOR.h>
+#include <ArduinoCommon/Sensors/StaticAnalogSensor.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+/**
+ * @brief Non-virtual soil moisture sensor for compile-time sensor sets.
+ *
+ * Produces the same readings as SoilSensor (same calibration record and
+ * percent mapping) through StaticAnalogSensor, so readRaw()/readPercent()
+ * inline down to an analogRead() plus a multiply and shift. It omits the
+ * runtime extras of SoilSensor (storage, scanner, async sampling); use
+ * SoilSensor when those are needed.
+ */
+class StaticSoilSensor : public StaticAnalogSensor<StaticSoilSensor> {
+ private:
+  uint8_t _inputPin;
+  bool _validConfig;
+  SoilCalibration _calibration;
+  PercentMap _percentMap;
+
+ public:
+  /**
+   * @brief Construct a sensor on an analog pin (reserved in begin()).
+   */
+  explicit StaticSoilSensor(uint8_t pin)
+      : _inputPin(pin), _validConfig(false), _calibration(), _percentMap() {}
+
+  /**
+   * @brief Reserve the pin and apply an optional calibration.
+   *
+   * @return true If the pin was reserved.
+   */
+  bool begin(int16_t dryCalibration = -1, int16_t wetCalibration = -1);
+
+  /**
+   * @brief Release the pin reserved by begin().
+   */
+  void end();
+
+  /**
+   * @brief Replace the in-memory calibration.
+   */
+  void setCalibration(int16_t dryRaw, int16_t wetRaw);
+
+  SoilCalibration getCalibration() const { return _calibration; }
+
+  bool hasCalibration() const { return _calibration.isValid(); }
+
+  bool validConfiguration() const { return _validConfig; }
+
+  int readRaw() const {
+    if (!_validConfig) return -1;
+    return analogRead(_inputPin);
+  }
+
+  int rawToPercent(int raw) const {
+    if (!_percentMap.valid) {
+      return map(raw, 0, AdcResolution::maxValue(AdcResolution::bits()), 0,
+                 100);
+    }
+    return _percentMap.toPercent(raw);
+  }
+
+  int readPercent() const {
+    const int raw = readRaw();
+    if (raw < 0) return 0;
+    return rawToPercent(raw);
+  }
+};
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef ARDUINOCOMMON_UTILS_I2CBUSMANAGER_H
+#define ARDUINOCOMMON_UTILS_I2CBUSMANAGER_H
+
+#include <Arduino.h>
+
+#ifndef ARDUINOCOMMON_MAX_I2C_BUSES
+/// Distinct SDA/SCL pairs I2cBusManager can track.
+#define ARDUINOCOMMON_MAX_I2C_BUSES 2
+#endif
+
+namespace ArduinoCommon {
+namespace Utils {
+
+/**
+ * @brief Shared ownership of I2C bus pins.
+ *
+ * An I2C bus is shared by every device on it, but PinManager only
+ * allows a pin to be reserved once. I2cBusManager reserves a bus's SDA
+ * and SCL pins with PinManager for its first user, counts further users
+ * of the same pair, and releases the pins when the last one is done.
+ *
+ * A bus is also tied to the controller (the TwoWire object) that drives
+ * it. A controller drives one pin pair at a time: on ESP32, starting
+ * Wire on a second pair would take it away from the first.
+ *
+ * All methods are static, like PinManager's.
+ *
+ * @code
+ * // Two displays on one bus at different addresses:
+ * LCD1602 status(SDA, SCL, 0x27);   // reserves SDA/SCL
+ * LCD2004 details(SDA, SCL, 0x3F);  // shares them
+ * @endcode
+ */
+class I2cBusManager {
+ public:
+  static constexpr uint8_t MaxBuses = ARDUINOCOMMON_MAX_I2C_BUSES;
+
+  /**
+   * @brief Start using the bus on @p sda / @p scl.
+   *
+   * @param controller Object driving the bus (e.g. &Wire), or nullptr
+   *                   if the caller does not drive it itself.
+   *
+   * @return true  If the pins were reserved now or already belong to
+   *               this bus and controller.
+   * @return false If either pin is reserved for something else (or for
+   *               a bus with a different pairing or controller), the
+   *               controller already drives another pair, or all
+   *               MaxBuses slots are taken.
+   */
+  static bool acquire(uint8_t sda, uint8_t scl,
+                      const void* controller = nullptr);
+
+  /**
+   * @brief Stop using the bus; the last user releases the pins.
+   *
+   * Has no effect if the pair was not acquired.
+   */
+  static void release(uint8_t sda, uint8_t scl);
+
+  /// Number of current users of the bus on @p sda / @p scl.
+  static uint8_t userCount(uint8_t sda, uint8_t scl);
+
+ private:
+  struct Bus {
+    uint8_t sda;
+    uint8_t scl;
+    uint8_t users;           ///< 0 = slot free
+    const void* controller;  ///< Object driving the bus, or nullptr
+  };
+
+  static Bus buses[MaxBuses];
+
+  static Bus* find(uint8_t sda, uint8_t scl);
+};
+
+}  // namespace Utils
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef ARDUINOCOMMON_UTILS_RINGBUFFER_H
+#define ARDUINOCOMMON_UTILS_RINGBUFFER_H
+
+#include <Arduino.h>
+
+namespace ArduinoCommon {
+namespace Utils {
+
+/**
+ * @brief Fixed-capacity, single-producer/single-consumer ring buffer.
+ *
+ * The producer (e.g. an ADC interrupt) only writes the head index and
+ * the consumer (the main loop) only writes the tail index, so no locking
+ * is required as long as there is exactly one of each. When the buffer
+ * is full the oldest entries are overwritten; the consumer detects the
+ * overrun and skips ahead to the oldest entry still present.
+ *
+ * All storage is static; no heap allocation is performed.
+ *
+ * @tparam T        Element type. Should be cheap to copy.
+ * @tparam Capacity Number of slots. Must be a power of two in [2,128].
+ */
+template <typename T, uint8_t Capacity>
+class RingBuffer {
+  static_assert(Capacity >= 2 && Capacity <= 128,
+                "RingBuffer: Capacity must be in [2,128].");
+  static_assert((Capacity & (Capacity - 1)) == 0,
+                "RingBuffer: Capacity must be a power of two.");
+
+ private:
+  static constexpr uint8_t Mask = Capacity - 1;
+
+  T _items[Capacity];
+  volatile uint32_t _head = 0;  ///< Total pushes (producer).
+  volatile bool _hasData = false;
+  uint32_t _tail = 0;           ///< Next entry to pop (consumer).
+
+  // The counters are 32 bits wide so that a consumer lagging by any
+  // realistic number of pushes still sees the overrun; a narrow counter
+  // wraps, and a consumer a whole number of wraps behind sees nothing.
+
+  /// Consumer-side read of _head. On 8-bit targets a multi-byte read can
+  /// be split by the producer's interrupt, so read until two agree.
+  uint32_t loadHead() const {
+    uint32_t head;
+    do {
+      head = _head;
+    } while (head != _head);
+    return head;
+  }
+
+ public:
+  /**
+   * @brief Append a value, overwriting the oldest entry when full.
+   *
+   * Producer side; safe to call from an interrupt handler.
+   *
+   * @param value The value to store.
+   */
+  void push(const T& value) {
+    const uint32_t head = _head;
+    _items[head & Mask] = value;
+    _head = head + 1;
+    _hasData = true;
+  }
+
+  /**
+   * @brief Remove and return the oldest entry.
+   *
+   * Consumer side. If the producer has overrun the consumer, entries that
+   * were overwritten are skipped.
+   *
+   * @param out Receives the oldest entry on success.
+   * @return true  If an entry was returned.
+   * @return false If the buffer is empty.
+   */
+  bool pop(T& out) {
+    for (;;) {
+      uint32_t head = loadHead();
+      if (head - _tail > Capacity) _tail = head - Capacity;
+      if (_tail == head) return false;
+
+      out = _items[_tail & Mask];
+
+      // If the producer lapped us while copying, the value may be torn.
+      head = loadHead();
+      if (head - _tail > Capacity) continue;
+
+      ++_tail;
+      return true;
+    }
+  }
+
+  /**
+   * @brief Read the most recently pushed value without consuming it.
+   *
+   * @param out Receives the newest entry on success.
+   * @return true  If at least one value has ever been pushed.
+   * @return false If the buffer has never received a value.
+   */
+  bool latest(T& out) const {
+    if (!_hasData) return false;
+    out = _items[(loadHead() - 1) & Mask];
+    return true;
+  }
+
+  /**
+   * @brief Number of entries available to pop(), at most Capacity.
+   */
+  uint8_t available() const {
+    const uint32_t pending = loadHead() - _tail;
+    return pending > Capacity ? Capacity : static_cast<uint8_t>(pending);
+  }
+
+  /**
+   * @brief Discard all entries (consumer side).
+   */
+  void clear() { _tail = loadHead(); }
+
+  /**
+   * @brief Fixed number of slots in this buffer.
+   */
+  static constexpr uint8_t capacity() { return Capacity; }
+};
+
+}  // namespace Utils
+}  // namespace ArduinoCommon
+
+#endif
@@ -0,0 +1,157 @@
+#include <ArduinoCommon/Config/AtomicStorage.h>
+#include <ArduinoCommon/Config/Crc16.h>
+#include <string.h>
+
+namespace ArduinoCommon {
+namespace Config {
+
+namespace {
+
+constexpr uint16_t ChunkSize = 16;
+
+uint16_t chunkLength(uint16_t offset, uint16_t size) {
+  const uint16_t left = static_cast<uint16_t>(size - offset);
+  return left < ChunkSize ? left : ChunkSize;
+}
+
+}  // namespace
+
+AtomicStorage::AtomicStorage(IConfigStorage& backing, uint16_t base,
+                             uint16_t size)
+    : _backing(backing), _base(base), _size(size) {}
+
+uint16_t AtomicStorage::headerCrc(const SlotHeader& header) {
+  const uint16_t crc =
+      Crc16::update(Crc16::Init, &header.sequence, sizeof(header.sequence));
+  return Crc16::update(crc, &header.payloadCrc, sizeof(header.payloadCrc));
+}
+
+bool AtomicStorage::begin() {
+  _active = -1;
+  _sequence = 0;
+
+  for (uint8_t slot = 0; slot < 2; ++slot) {
+    SlotHeader header;
+    if (!_backing.read(slotStart(slot), &header, HeaderSize)) continue;
+    if (header.sequence == 0xFFFFFFFFUL) continue;  // erased
+    if (header.headerCrc != headerCrc(header)) continue;
+
+    if (_active < 0 ||
+        static_cast<int32_t>(header.sequence - _sequence) > 0) {
+      _active = static_cast<int8_t>(slot);
+      _sequence = header.sequence;
+    }
+  }
+  return _active >= 0;
+}
+
+bool AtomicStorage::verify() {
+  if (_active < 0) return false;
+  SlotHeader header;
+  if (!_backing.read(slotStart(_active), &header, HeaderSize)) return false;
+
+  uint16_t crc = Crc16::Init;
+  uint8_t chunk[ChunkSize];
+  for (uint16_t offset = 0; offset < _size; offset += ChunkSize) {
+    const uint16_t n = chunkLength(offset, _size);
+    if (!readCurrent(offset, chunk, n)) return false;
+    crc = Crc16::update(crc, chunk, n);
+  }
+  return crc == header.payloadCrc;
+}
+
+bool AtomicStorage::readCurrent(uint16_t offset, uint8_t* data, uint16_t len) {
+  if (_active < 0) {
+    memset(data, 0xFF, len);
+    return true;
+  }
+  return _backing.read(slotStart(_active) + HeaderSize + offset, data, len);
+}
+
+bool AtomicStorage::read(uint16_t key, void* data, size_t len) {
+  if (static_cast<size_t>(key) + len > _size) return false;
+  return readCurrent(key, static_cast<uint8_t*>(data),
+                     static_cast<uint16_t>(len));
+}
+
+bool AtomicStorage::isUsed(uint16_t key, size_t len) {
+  if (static_cast<size_t>(key) + len > _size) return false;
+  uint8_t chunk[ChunkSize];
+  const uint16_t end = static_cast<uint16_t>(key + len);
+  for (uint16_t offset = key; offset < end; offset += ChunkSize) {
+    const uint16_t n = chunkLength(offset, end);
+    if (!readCurrent(offset, chunk, n)) return false;
+    for (uint16_t i = 0; i < n; ++i) {
+      if (chunk[i] != 0xFF) return true;
+    }
+  }
+  return false;
+}
+
+bool AtomicStorage::write(uint16_t key, const void* data, size_t len) {
+  if (static_cast<size_t>(key) + len > _size) return false;
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+  // Skip the commit if nothing changes.
+  uint8_t chunk[ChunkSize];
+  const uint16_t end = static_cast<uint16_t>(key + len);
+  for (uint16_t offset = key; offset < end; offset += ChunkSize) {
+    const uint16_t n = chunkLength(offset, end);
+    if (!readCurrent(offset, chunk, n)) return false;
+    if (memcmp(chunk, bytes + (offset - key), n) != 0) {
+      return commit(key, bytes, static_cast<uint16_t>(len));
+    }
+  }
+  return true;
+}
+
+bool AtomicStorage::clear(uint16_t key, size_t len) {
+  if (static_cast<size_t>(key) + len > _size) return false;
+  if (!isUsed(key, len)) return true;
+  return commit(key, nullptr, static_cast<uint16_t>(len));
+}
+
+bool AtomicStorage::commit(uint16_t key, const uint8_t* data, uint16_t len) {
+  const uint8_t target = _active == 0 ? 1 : 0;
+  const uint16_t targetData = slotStart(target) + HeaderSize;
+  const uint16_t end = static_cast<uint16_t>(key + len);
+
+  uint16_t crc = Crc16::Init;
+  uint8_t next[ChunkSize];
+  uint8_t old[ChunkSize];
+  for (uint16_t offset = 0; offset < _size; offset += ChunkSize) {
+    const uint16_t n = chunkLength(offset, _size);
+    if (!readCurrent(offset, next, n)) return false;
+    for (uint16_t i = 0; i < n; ++i) {
+      const uint16_t at = static_cast<uint16_t>(offset + i);
+      if (at >= key && at < end) next[i] = data ? data[at - key] : 0xFF;
+    }
+    crc = Crc16::update(crc, next, n);
+
+    // Rewrite only the span that differs from the slot's old contents.
+    if (!_backing.read(targetData + offset, old, n)) return false;
+    uint16_t first = 0;
+    while (first < n && old[first] == next[first]) ++first;
+    if (first == n) continue;
+    uint16_t last = static_cast<uint16_t>(n - 1);
+    while (old[last] == next[last]) --last;
+    if (!_backing.write(targetData + offset + first, next + first,
+                        last - first + 1)) {
+      return false;
+    }
+  }
+
+  // The header goes last: until it is complete, the old slot stays active.
+  SlotHeader header;
+  header.sequence = _sequence + 1;
+  header.payloadCrc = crc;
+  header.headerCrc = headerCrc(header);
+  if (!_backing.write(slotStart(target), &header, HeaderSize)) return false;
+
+  _active = static_cast<int8_t>(target);
+  _sequence = header.sequence;
+  return true;
+}
+
+}  // namespace Config
+}  // namespace ArduinoCommon
@@ -0,0 +1,124 @@
+#include <ArduinoCommon/Config/ConfigRecord.h>
+#include <ArduinoCommon/Config/Crc16.h>
+#include <string.h>
+
+namespace ArduinoCommon {
+namespace Config {
+
+uint16_t ConfigRecord::headerCrc(const RecordHeader& header) {
+  uint16_t crc = Crc16::update(Crc16::Init, &header.type, sizeof(header.type));
+  crc = Crc16::update(crc, &header.length, sizeof(header.length));
+  return Crc16::update(crc, &header.version, sizeof(header.version));
+}
+
+RecordStatus ConfigRecord::readHeader(IConfigStorage& storage, uint16_t key,
+                                      RecordHeader& header) {
+  if (!storage.read(key, &header, HeaderSize)) {
+    return RecordStatus::StorageError;
+  }
+  if (header.magic == 0xFFFF) return RecordStatus::Empty;
+  if (header.magic != Magic) return RecordStatus::Corrupt;
+  return RecordStatus::Ok;
+}
+
+bool ConfigRecord::write(IConfigStorage& storage, uint16_t key, uint16_t type,
+                         uint8_t version, const void* data, uint16_t length) {
+  RecordHeader header;
+  header.magic = Magic;
+  header.type = type;
+  header.length = length;
+  header.version = version;
+  header.flags = 0xFF;
+  header.crc = Crc16::update(headerCrc(header), data, length);
+
+  if (storedSize(length) <= ARDUINOCOMMON_CONFIG_RECORD_BUFFER) {
+    uint8_t buffer[ARDUINOCOMMON_CONFIG_RECORD_BUFFER];
+    memcpy(buffer, &header, HeaderSize);
+    memcpy(buffer + HeaderSize, data, length);
+    return storage.write(key, buffer, storedSize(length));
+  }
+
+  // Payload first, so an interrupted write never pairs the new header
+  // with the old payload without failing the CRC.
+  return storage.write(key + HeaderSize, data, length) &&
+         storage.write(key, &header, HeaderSize);
+}
+
+RecordStatus ConfigRecord::read(IConfigStorage& storage, uint16_t key,
+                                uint16_t type, void* data, uint16_t capacity,
+                                Info* info) {
+  RecordHeader header;
+  const RecordStatus status = readHeader(storage, key, header);
+  if (status != RecordStatus::Ok) return status;
+
+  if (info) {
+    info->key = key;
+    info->type = header.type;
+    info->length = header.length;
+    info->version = header.version;
+    info->flags = header.flags;
+  }
+  if (header.type != type) return RecordStatus::WrongType;
+  if (header.length > capacity) return RecordStatus::TooLarge;
+
+  if (!storage.read(key + HeaderSize, data, header.length)) {
+    return RecordStatus::StorageError;
+  }
+  const uint16_t crc = Crc16::update(headerCrc(header), data, header.length);
+  return crc == header.crc ? RecordStatus::Ok : RecordStatus::Corrupt;
+}
+
+RecordStatus ConfigRecord::validate(IConfigStorage& storage, uint16_t key,
+                                    Info* info) {
+  RecordHeader header;
+  const RecordStatus status = readHeader(storage, key, header);
+  if (status != RecordStatus::Ok) return status;
+
+  uint16_t crc = headerCrc(header);
+  uint8_t chunk[16];
+  for (uint16_t done = 0; done < header.length;) {
+    uint16_t n = static_cast<uint16_t>(header.length - done);
+    if (n > sizeof(chunk)) n = sizeof(chunk);
+    if (!storage.read(key + HeaderSize + done, chunk, n)) {
+      return RecordStatus::StorageError;
+    }
+    crc = Crc16::update(crc, chunk, n);
+    done = static_cast<uint16_t>(done + n);
+  }
+  if (crc != header.crc) return RecordStatus::Corrupt;
+
+  if (info) {
+    info->key = key;
+    info->type = header.type;
+    info->length = header.length;
+    info->version = header.version;
+    info->flags = header.flags;
+  }
+  return RecordStatus::Ok;
+}
+
+RecordStatus ConfigRecord::scan(IConfigStorage& storage, uint16_t begin,
+                                uint16_t end, Visitor visit, void* context,
+                                uint16_t* stopKey) {
+  uint16_t key = begin;
+  RecordStatus result = RecordStatus::Ok;
+
+  while (static_cast<uint32_t>(key) + HeaderSize <= end) {
+    Info info;
+    const RecordStatus status = validate(storage, key, &info);
+    if (status == RecordStatus::Empty) break;
+    if (status != RecordStatus::Ok ||
+        static_cast<uint32_t>(key) + storedSize(info.length) > end) {
+      result = status == RecordStatus::Ok ? RecordStatus::Corrupt : status;
+      break;
+    }
+    if (visit) visit(info, context);
+    key = static_cast<uint16_t>(key + storedSize(info.length));
+  }
+
+  if (stopKey) *stopKey = key;
+  return result;
+}
+
+}  // namespace Config
+}  // namespace ArduinoCommon
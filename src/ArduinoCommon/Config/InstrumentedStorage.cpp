@@ -0,0 +1,245 @@
+#include <ArduinoCommon/Config/InstrumentedStorage.h>
+
+namespace ArduinoCommon {
+namespace Config {
+
+namespace {
+
+constexpr uint8_t ChunkSize = 16;
+
+void printHistogram(Stream& out, const __FlashStringHelper* label,
+                    const LatencyHistogram& histogram) {
+  out.print(F("  "));
+  out.print(label);
+  out.print(F(": "));
+  out.print(histogram.calls);
+  out.print(F(" calls"));
+  if (histogram.calls == 0) {
+    out.println();
+    return;
+  }
+  out.print(F(", avg "));
+  out.print(histogram.totalMicros / histogram.calls);
+  out.print(F(" us, max "));
+  out.print(histogram.maxMicros);
+  out.println(F(" us"));
+
+  for (uint8_t i = 0; i < LatencyHistogram::Buckets; ++i) {
+    if (histogram.counts[i] == 0) continue;
+    const uint32_t limit = LatencyHistogram::bucketLimit(i);
+    out.print(F("    "));
+    if (limit) {
+      out.print(F("< "));
+      out.print(limit);
+    } else {
+      out.print(F(">= "));
+      out.print(LatencyHistogram::bucketLimit(i - 1));
+    }
+    out.print(F(" us: "));
+    out.println(histogram.counts[i]);
+  }
+}
+
+void printRegion(Stream& out, const StorageRegionStats& region,
+                 uint32_t elapsedMs) {
+  out.print(F("  "));
+  out.print(region.name ? region.name : "(other)");
+  if (region.name) {
+    out.print(F(" ["));
+    out.print(region.begin);
+    out.print(F(".."));
+    out.print(static_cast<uint32_t>(region.begin) + region.length);
+    out.print(F(")"));
+  }
+  out.println();
+
+  out.print(F("    reads "));
+  out.print(region.reads);
+  out.print(F(" ("));
+  out.print(region.bytesRead);
+  out.print(F(" B), writes "));
+  out.print(region.writes);
+  out.print(F(", clears "));
+  out.print(region.clears);
+  out.print(F(", failures "));
+  out.println(region.failures);
+
+  out.print(F("    commits "));
+  out.print(region.commits);
+  out.print(F(", no-ops "));
+  out.print(region.noOps);
+  out.print(F(", bytes "));
+  out.print(region.bytesChanged);
+  out.print(F(" changed / "));
+  out.print(region.bytesWritten);
+  out.print(F(" written"));
+  if (elapsedMs >= 1000) {
+    out.print(F(", "));
+    out.print(static_cast<uint32_t>(static_cast<uint64_t>(region.commits) *
+                                    3600000UL / elapsedMs));
+    out.print(F(" commits/h"));
+  }
+  out.println();
+}
+
+}  // namespace
+
+void LatencyHistogram::record(uint32_t micros) {
+  uint8_t bucket = 0;
+  while (bucket + 1 < Buckets && micros >= bucketLimit(bucket)) ++bucket;
+  ++counts[bucket];
+  ++calls;
+  totalMicros += micros;
+  if (micros > maxMicros) maxMicros = micros;
+}
+
+void LatencyHistogram::reset() { *this = LatencyHistogram(); }
+
+void StorageRegionStats::reset() {
+  const char* keepName = name;
+  const uint16_t keepBegin = begin;
+  const uint16_t keepLength = length;
+  *this = StorageRegionStats();
+  name = keepName;
+  begin = keepBegin;
+  length = keepLength;
+}
+
+InstrumentedStorage::InstrumentedStorage(IConfigStorage& backing)
+    : _backing(backing), _sinceMs(millis()) {}
+
+bool InstrumentedStorage::addRegion(const char* name, uint16_t begin,
+                                    uint16_t length) {
+  if (_regionCount >= MaxRegions) return false;
+  StorageRegionStats& region = _regions[_regionCount++];
+  region = StorageRegionStats();
+  region.name = name;
+  region.begin = begin;
+  region.length = length;
+  return true;
+}
+
+StorageRegionStats& InstrumentedStorage::regionFor(uint16_t key) {
+  for (uint8_t i = 0; i < _regionCount; ++i) {
+    StorageRegionStats& region = _regions[i];
+    if (key >= region.begin &&
+        static_cast<uint32_t>(key) <
+            static_cast<uint32_t>(region.begin) + region.length) {
+      return region;
+    }
+  }
+  return _other;
+}
+
+void InstrumentedStorage::resetStats() {
+  for (uint8_t i = 0; i < _regionCount; ++i) _regions[i].reset();
+  _other.reset();
+  _readLatency.reset();
+  _writeLatency.reset();
+  _clearLatency.reset();
+  _sinceMs = millis();
+}
+
+uint32_t InstrumentedStorage::countChanges(uint16_t key, const uint8_t* data,
+                                           size_t len) {
+  uint32_t changed = 0;
+  uint8_t chunk[ChunkSize];
+  for (size_t offset = 0; offset < len; offset += ChunkSize) {
+    const size_t n = len - offset < ChunkSize ? len - offset : ChunkSize;
+    if (!_backing.read(static_cast<uint16_t>(key + offset), chunk, n)) {
+      return static_cast<uint32_t>(len);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const uint8_t value = data ? data[offset + i] : 0xFF;
+      if (chunk[i] != value) ++changed;
+    }
+  }
+  return changed;
+}
+
+void InstrumentedStorage::recordWrite(StorageRegionStats& region, size_t len,
+                                      uint32_t changed, bool ok) {
+  region.bytesWritten += len;
+  if (!ok) {
+    ++region.failures;
+    return;
+  }
+  region.bytesChanged += changed;
+  if (changed) {
+    ++region.commits;
+  } else {
+    ++region.noOps;
+  }
+}
+
+bool InstrumentedStorage::read(uint16_t key, void* data, size_t len) {
+  const uint32_t start = micros();
+  const bool ok = _backing.read(key, data, len);
+  _readLatency.record(micros() - start);
+
+  StorageRegionStats& region = regionFor(key);
+  ++region.reads;
+  region.bytesRead += len;
+  if (!ok) ++region.failures;
+  return ok;
+}
+
+bool InstrumentedStorage::isUsed(uint16_t key, size_t len) {
+  const uint32_t start = micros();
+  const bool used = _backing.isUsed(key, len);
+  _readLatency.record(micros() - start);
+
+  StorageRegionStats& region = regionFor(key);
+  ++region.reads;
+  region.bytesRead += len;
+  return used;
+}
+
+bool InstrumentedStorage::write(uint16_t key, const void* data, size_t len) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  const uint32_t changed = countChanges(key, bytes, len);
+
+  const uint32_t start = micros();
+  const bool ok = _backing.write(key, data, len);
+  _writeLatency.record(micros() - start);
+
+  StorageRegionStats& region = regionFor(key);
+  ++region.writes;
+  recordWrite(region, len, changed, ok);
+  return ok;
+}
+
+bool InstrumentedStorage::clear(uint16_t key, size_t len) {
+  const uint32_t changed = countChanges(key, nullptr, len);
+
+  const uint32_t start = micros();
+  const bool ok = _backing.clear(key, len);
+  _clearLatency.record(micros() - start);
+
+  StorageRegionStats& region = regionFor(key);
+  ++region.clears;
+  recordWrite(region, len, changed, ok);
+  return ok;
+}
+
+void InstrumentedStorage::dumpStats(Stream& out) const {
+  const uint32_t elapsedMs = millis() - _sinceMs;
+  out.print(F("[InstrumentedStorage] Stats over "));
+  out.print(elapsedMs / 1000);
+  out.println(F(" s:"));
+
+  for (uint8_t i = 0; i < _regionCount; ++i) {
+    printRegion(out, _regions[i], elapsedMs);
+  }
+  if (_other.reads || _other.writes || _other.clears) {
+    printRegion(out, _other, elapsedMs);
+  }
+
+  out.println(F("[InstrumentedStorage] Latency:"));
+  printHistogram(out, F("read"), _readLatency);
+  printHistogram(out, F("write"), _writeLatency);
+  printHistogram(out, F("clear"), _clearLatency);
+}
+
+}  // namespace Config
+}  // namespace ArduinoCommon
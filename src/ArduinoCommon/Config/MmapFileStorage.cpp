@@ -0,0 +1,78 @@
+#include <ArduinoCommon/Config/MmapFileStorage.h>
+
+#if ARDUINOCOMMON_HAS_MMAP
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ArduinoCommon {
+namespace Config {
+
+MmapFileStorage::MmapFileStorage(const StorageSimulation& simulation)
+    : SimulatedStorage(simulation) {}
+
+MmapFileStorage::~MmapFileStorage() { close(); }
+
+bool MmapFileStorage::open(const char* path, size_t size) {
+  close();
+  if (size == 0) return false;
+
+  _fd = ::open(path, O_RDWR | O_CREAT, 0644);
+  if (_fd < 0) return false;
+
+  struct stat info;
+  if (fstat(_fd, &info) != 0) {
+    close();
+    return false;
+  }
+  const size_t existing = static_cast<size_t>(info.st_size);
+  if (existing < size && ftruncate(_fd, static_cast<off_t>(size)) != 0) {
+    close();
+    return false;
+  }
+
+  void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+  if (map == MAP_FAILED) {
+    close();
+    return false;
+  }
+  _map = static_cast<uint8_t*>(map);
+  _mapSize = size;
+
+  // ftruncate() zero-fills; new bytes must read as erased.
+  if (existing < size) memset(_map + existing, 0xFF, size - existing);
+
+  _wear = new uint32_t[size]();
+  attach(_map, _wear, size);
+  resetStats();
+  return true;
+}
+
+bool MmapFileStorage::sync() {
+  if (!_map) return false;
+  return msync(_map, _mapSize, MS_SYNC) == 0;
+}
+
+void MmapFileStorage::close() {
+  attach(nullptr, nullptr, 0);
+  if (_map) {
+    msync(_map, _mapSize, MS_SYNC);
+    munmap(_map, _mapSize);
+    _map = nullptr;
+  }
+  delete[] _wear;
+  _wear = nullptr;
+  _mapSize = 0;
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+}
+
+}  // namespace Config
+}  // namespace ArduinoCommon
+
+#endif  // ARDUINOCOMMON_HAS_MMAP
@@ -0,0 +1,136 @@
+#include <ArduinoCommon/Config/SimulatedStorage.h>
+#include <string.h>
+
+namespace ArduinoCommon {
+namespace Config {
+
+SimulatedStorage::SimulatedStorage(const StorageSimulation& simulation) {
+  setSimulation(simulation);
+}
+
+void SimulatedStorage::attach(uint8_t* bytes, uint32_t* cellWrites,
+                              size_t size) {
+  _bytes = bytes;
+  _cellWrites = cellWrites;
+  _size = size;
+}
+
+void SimulatedStorage::resetStats() {
+  _readCalls = 0;
+  _writeCalls = 0;
+  _bytesRead = 0;
+  _bytesProgrammed = 0;
+  _bytesSkipped = 0;
+  _blockErases = 0;
+  _simulatedMicros = 0;
+  if (_cellWrites) memset(_cellWrites, 0, _size * sizeof(uint32_t));
+}
+
+uint32_t SimulatedStorage::maxCellWrites(size_t key, size_t len) const {
+  uint32_t highest = 0;
+  for (size_t i = key; i < key + len && i < _size; ++i) {
+    if (_cellWrites[i] > highest) highest = _cellWrites[i];
+  }
+  return highest;
+}
+
+void SimulatedStorage::spend(uint32_t micros) {
+  if (micros == 0) return;
+  _simulatedMicros += micros;
+  if (_simulation.realDelay) delayMicroseconds(micros);
+}
+
+bool SimulatedStorage::read(uint16_t key, void* data, size_t len) {
+  if (!inRange(key, len)) return false;
+  memcpy(data, _bytes + key, len);
+  ++_readCalls;
+  _bytesRead += len;
+  return true;
+}
+
+bool SimulatedStorage::write(uint16_t key, const void* data, size_t len) {
+  if (!inRange(key, len)) return false;
+  ++_writeCalls;
+  store(key, static_cast<const uint8_t*>(data), len);
+  return true;
+}
+
+bool SimulatedStorage::isUsed(uint16_t key, size_t len) {
+  if (!inRange(key, len)) return false;
+  ++_readCalls;
+  _bytesRead += len;
+  for (size_t i = 0; i < len; ++i) {
+    if (_bytes[key + i] != 0xFF) return true;
+  }
+  return false;
+}
+
+bool SimulatedStorage::clear(uint16_t key, size_t len) {
+  if (!inRange(key, len)) return false;
+  ++_writeCalls;
+  store(key, nullptr, len);
+  return true;
+}
+
+void SimulatedStorage::store(size_t key, const uint8_t* data, size_t len) {
+  const size_t block = _simulation.eraseBlockSize;
+  const size_t end = key + len;
+  uint32_t programmed = 0;
+  uint32_t erased = 0;
+
+  for (size_t blockStart = key - key % block; blockStart < end;
+       blockStart += block) {
+    const size_t blockEnd = blockStart + block < _size ? blockStart + block
+                                                       : _size;
+    const size_t from = blockStart > key ? blockStart : key;
+    const size_t to = blockEnd < end ? blockEnd : end;
+
+    // Programming can only clear bits; setting any bit back to 1 needs an
+    // erase. With a block size of 1 every cell is its own block, which is
+    // how an EEPROM erase-write cycle behaves.
+    bool needsErase = false;
+    for (size_t i = from; i < to; ++i) {
+      const uint8_t value = data ? data[i - key] : 0xFF;
+      if (value & ~_bytes[i]) {
+        needsErase = true;
+        break;
+      }
+    }
+
+    if (needsErase && block > 1) {
+      // Erase the block, then program back every cell that is not 0xFF:
+      // the old contents outside [key, end) and the new data inside it.
+      ++erased;
+      for (size_t i = blockStart; i < blockEnd; ++i) {
+        const uint8_t value =
+            i >= from && i < to ? (data ? data[i - key] : 0xFF) : _bytes[i];
+        ++_cellWrites[i];
+        if (value != 0xFF) {
+          ++_cellWrites[i];
+          ++programmed;
+        }
+        _bytes[i] = value;
+      }
+      continue;
+    }
+
+    for (size_t i = from; i < to; ++i) {
+      const uint8_t value = data ? data[i - key] : 0xFF;
+      if (value == _bytes[i] && _simulation.skipUnchanged) {
+        ++_bytesSkipped;
+        continue;
+      }
+      ++_cellWrites[i];
+      ++programmed;
+      _bytes[i] = value;
+    }
+  }
+
+  _bytesProgrammed += programmed;
+  _blockErases += erased;
+  spend(programmed * _simulation.writeLatencyUs +
+        erased * _simulation.eraseLatencyUs);
+}
+
+}  // namespace Config
+}  // namespace ArduinoCommon
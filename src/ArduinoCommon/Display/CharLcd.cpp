@@ -0,0 +1,68 @@
+#include <ArduinoCommon/Display/CharLcd.h>
+#include <ArduinoCommon/Display/Pcf8574Lcd.h>
+#include <ArduinoCommon/Utils/I2cBusManager.h>
+
+namespace ArduinoCommon {
+namespace Display {
+
+CharLcdBase::CharLcdBase(uint8_t sdaP, uint8_t sclP, uint8_t address,
+                         uint8_t numCols, uint8_t numRows,
+                         LcdI2cBus& bus) noexcept
+    : autoFlush(true),
+      lcd(nullptr),
+      sdaPin(sdaP),
+      sclPin(sclP),
+      i2cAddress(address),
+      validConfig(false),
+      initialized(false),
+      busClock(KeepClock) {
+  if (!Utils::I2cBusManager::acquire(sdaPin, sclPin, &bus)) return;
+
+  lcd = new Pcf8574Lcd(i2cAddress, numCols, numRows, bus);
+  validConfig = true;
+}
+
+CharLcdBase::~CharLcdBase() {
+  if (lcd) {
+    delete lcd;
+    lcd = nullptr;
+  }
+  if (validConfig) {
+    Utils::I2cBusManager::release(sdaPin, sclPin);
+  }
+}
+
+bool CharLcdBase::beginDriver() {
+  if (!validConfig || lcd == nullptr) return false;
+
+  LcdI2cBus& bus = lcd->bus();
+#if defined(ESP32)
+  bus.begin(sdaPin, sclPin);
+#else
+  bus.begin();
+#endif
+  if (busClock != KeepClock) bus.setClock(busClock);
+
+  if (!lcd->probe()) return false;
+
+  lcd->init();
+  lcd->backlight();
+  initialized = true;
+  return true;
+}
+
+void CharLcdBase::setBusClock(uint32_t hz) noexcept {
+  busClock = hz;
+  if (initialized && hz != KeepClock) lcd->bus().setClock(hz);
+}
+
+void CharLcdBase::moveTo(uint8_t ddram) { lcd->setAddress(ddram); }
+
+void CharLcdBase::send(const char* cells, uint8_t len) {
+  lcd->write(cells, len);
+}
+
+void CharLcdBase::commit() { lcd->commit(); }
+
+}  // namespace Display
+}  // namespace ArduinoCommon
@@ -0,0 +1,161 @@
+#include <ArduinoCommon/Display/LcdField.h>
+#include <string.h>
+
+namespace ArduinoCommon {
+namespace Display {
+
+namespace {
+
+// Digits of the largest unsigned long: 10 with a 32-bit long, 20 with a
+// 64-bit one (native builds). log10(2) ~ 0.302; <limits> is not
+// available on AVR.
+constexpr uint8_t MaxDigits = sizeof(unsigned long) * 8 * 302 / 1000 + 1;
+
+// Longest formatted number: sign, digits, decimal point, suffix.
+constexpr uint8_t NumberBufferSize = MaxDigits + 3;
+
+const long Pow10[] = {1L, 10L, 100L, 1000L, 10000L, 100000L, 1000000L};
+
+/// Round value * 10^decimals to a long.
+/// @return false for NaN or values out of range.
+bool toScaled(float value, uint8_t decimals, long& scaled) {
+  const float x = value * static_cast<float>(Pow10[decimals]);
+  // NaN fails both comparisons.
+  if (!(x > -2147483000.0f && x < 2147483000.0f)) return false;
+  scaled = static_cast<long>(x < 0 ? x - 0.5f : x + 0.5f);
+  return true;
+}
+
+}  // namespace
+
+void LcdField::changed() {
+  if (onChange) onChange(context, row);
+}
+
+void LcdField::clear() {
+  if (width == 0) return;
+  memset(cells, ' ', width);
+  changed();
+}
+
+bool LcdField::overflow() {
+  if (width == 0) return false;
+  memset(cells, '#', width);
+  changed();
+  return false;
+}
+
+bool LcdField::place(const char* text, uint8_t len, bool numeric) {
+  if (width == 0) return len == 0;
+
+  const bool fits = len <= width;
+  if (!fits && numeric) return overflow();
+  if (!fits) len = width;
+
+  const Align where =
+      explicitAlign ? align : (numeric ? Align::Right : Align::Left);
+  const uint8_t padding = static_cast<uint8_t>(width - len);
+
+  if (where == Align::Left) {
+    memcpy(cells, text, len);
+    memset(cells + len, ' ', padding);
+  } else if (numeric && zeros) {
+    // The sign stays in front of the zeros: "-0042".
+    uint8_t at = 0;
+    if (len > 0 && text[0] == '-') {
+      cells[at++] = '-';
+      ++text;
+      --len;
+    }
+    memset(cells + at, '0', padding);
+    memcpy(cells + at + padding, text, len);
+  } else {
+    memset(cells, ' ', padding);
+    memcpy(cells + padding, text, len);
+  }
+
+  changed();
+  return fits;
+}
+
+bool LcdField::print(const char* text) {
+  const size_t len = text ? strlen(text) : 0;
+  return place(text, static_cast<uint8_t>(len > 255 ? 255 : len), false);
+}
+
+bool LcdField::print(const __FlashStringHelper* text) {
+  // Copy what fits; anything longer is cut off anyway.
+  const char* p = reinterpret_cast<const char*>(text);
+  char buffer[41];
+  uint8_t len = 0;
+  while (len < sizeof(buffer) && len <= width) {
+    const char c = static_cast<char>(pgm_read_byte(p + len));
+    if (c == '\0') break;
+    buffer[len++] = c;
+  }
+  const bool fits = len <= width;
+  place(buffer, fits ? len : width, false);
+  return fits;
+}
+
+bool LcdField::print(char c) { return place(&c, 1, false); }
+
+bool LcdField::placeNumber(long scaled, uint8_t decimals, char suffix) {
+  char buffer[NumberBufferSize];
+  uint8_t at = sizeof(buffer);
+
+  if (suffix) buffer[--at] = suffix;
+
+  // Work on the magnitude as unsigned so LONG_MIN is handled too.
+  const bool negative = scaled < 0;
+  unsigned long magnitude = negative ? 0UL - static_cast<unsigned long>(scaled)
+                                     : static_cast<unsigned long>(scaled);
+  uint8_t digits = 0;
+  do {
+    buffer[--at] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+    ++digits;
+    if (digits == decimals) buffer[--at] = '.';
+  } while (magnitude > 0 || digits <= decimals);
+
+  if (negative) buffer[--at] = '-';
+  return place(buffer + at, static_cast<uint8_t>(sizeof(buffer) - at), true);
+}
+
+bool LcdField::printInt(long value) { return placeNumber(value, 0, '\0'); }
+
+bool LcdField::printUnsigned(unsigned long value) {
+  char buffer[NumberBufferSize];
+  uint8_t at = sizeof(buffer);
+  do {
+    buffer[--at] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  return place(buffer + at, static_cast<uint8_t>(sizeof(buffer) - at), true);
+}
+
+bool LcdField::printScaled(long scaled, uint8_t decimals) {
+  if (decimals > MaxDecimals) decimals = MaxDecimals;
+  return placeNumber(scaled, decimals, '\0');
+}
+
+bool LcdField::printFixed(float value, uint8_t decimals) {
+  if (decimals > MaxDecimals) decimals = MaxDecimals;
+  long scaled;
+  if (!toScaled(value, decimals, scaled)) return overflow();
+  return placeNumber(scaled, decimals, '\0');
+}
+
+bool LcdField::printPercent(int percent) {
+  return placeNumber(percent, 0, '%');
+}
+
+bool LcdField::printPercent(float percent, uint8_t decimals) {
+  if (decimals > MaxDecimals) decimals = MaxDecimals;
+  long scaled;
+  if (!toScaled(percent, decimals, scaled)) return overflow();
+  return placeNumber(scaled, decimals, '%');
+}
+
+}  // namespace Display
+}  // namespace ArduinoCommon
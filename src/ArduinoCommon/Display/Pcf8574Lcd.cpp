@@ -0,0 +1,141 @@
+#include <ArduinoCommon/Display/Pcf8574Lcd.h>
+
+namespace ArduinoCommon {
+namespace Display {
+
+namespace {
+
+// HD44780 instructions used by the driver.
+constexpr uint8_t ClearDisplay = 0x01;
+constexpr uint8_t EntryModeIncrement = 0x06;
+constexpr uint8_t DisplayOn = 0x0C;  // display on, cursor and blink off
+constexpr uint8_t FunctionSet4Bit2Line = 0x28;
+constexpr uint8_t FunctionSet4Bit1Line = 0x20;
+constexpr uint8_t SetDdramAddress = 0x80;
+
+// Execution time of clear/home, which is far longer than the bus time.
+constexpr unsigned int ClearDelayUs = 2000;
+
+}  // namespace
+
+Pcf8574Lcd::Pcf8574Lcd(uint8_t addr, uint8_t numCols, uint8_t numRows,
+                       LcdI2cBus& bus) noexcept
+    : i2c(bus),
+      address(addr),
+      cols(numCols),
+      rows(numRows),
+      backlightBit(Backlight),
+      lastOutput(0),
+      lastAck(true),
+      pendingLength(0) {}
+
+bool Pcf8574Lcd::probe() {
+  i2c.beginTransmission(address);
+  return i2c.endTransmission() == 0;
+}
+
+void Pcf8574Lcd::queue(uint8_t value) {
+  if (pendingLength >= BufferSize) commit();
+  pending[pendingLength++] = value;
+  lastOutput = value;
+}
+
+bool Pcf8574Lcd::commit() {
+  if (pendingLength == 0) return lastAck;
+
+  i2c.beginTransmission(address);
+  for (uint16_t i = 0; i < pendingLength; ++i) i2c.write(pending[i]);
+  lastAck = i2c.endTransmission() == 0;
+  pendingLength = 0;
+  return lastAck;
+}
+
+void Pcf8574Lcd::sendNibble(uint8_t nibble, uint8_t rs) {
+  const uint8_t value =
+      static_cast<uint8_t>((nibble & 0xF0) | rs | backlightBit);
+
+  // RS must be stable before EN rises; it only needs its own byte when
+  // it changes, i.e. when switching between commands and characters.
+  if ((lastOutput & Rs) != rs) queue(value);
+
+  // Keep the enable pulse in one transmission.
+  if (pendingLength + 2 > BufferSize) commit();
+  queue(static_cast<uint8_t>(value | En));
+  queue(value);  // the HD44780 latches on the falling edge
+}
+
+void Pcf8574Lcd::sendByte(uint8_t value, uint8_t rs) {
+  sendNibble(value, rs);
+  sendNibble(static_cast<uint8_t>(value << 4), rs);
+}
+
+void Pcf8574Lcd::init() {
+  pendingLength = 0;
+  lastOutput = 0;
+
+  // Power-on wait, then the datasheet's "initialization by instruction":
+  // three 8-bit function sets, each a single nibble, then 4-bit mode.
+  delay(50);
+  queue(backlightBit);
+  commit();
+
+  sendNibble(0x30, 0);
+  commit();
+  delayMicroseconds(4500);
+  sendNibble(0x30, 0);
+  commit();
+  delayMicroseconds(150);
+  sendNibble(0x30, 0);
+  sendNibble(0x20, 0);
+
+  command(rows > 1 ? FunctionSet4Bit2Line : FunctionSet4Bit1Line);
+  command(DisplayOn);
+  command(EntryModeIncrement);
+  clear();
+}
+
+void Pcf8574Lcd::clear() {
+  command(ClearDisplay);
+  commit();
+  delayMicroseconds(ClearDelayUs);
+}
+
+void Pcf8574Lcd::backlight() {
+  backlightBit = Backlight;
+  queue(static_cast<uint8_t>(lastOutput | Backlight));
+  commit();
+}
+
+void Pcf8574Lcd::noBacklight() {
+  backlightBit = 0;
+  queue(static_cast<uint8_t>(lastOutput & ~Backlight));
+  commit();
+}
+
+void Pcf8574Lcd::setCursor(uint8_t col, uint8_t row) {
+  if (row >= rows) row = static_cast<uint8_t>(rows - 1);
+  const uint8_t offset =
+      static_cast<uint8_t>((row & 1 ? 0x40 : 0x00) + (row & 2 ? cols : 0));
+  setAddress(static_cast<uint8_t>(offset + col));
+}
+
+void Pcf8574Lcd::setAddress(uint8_t ddram) {
+  command(static_cast<uint8_t>(SetDdramAddress | ddram));
+}
+
+size_t Pcf8574Lcd::write(const char* text, size_t len) {
+  if (!text) return 0;
+  for (size_t i = 0; i < len; ++i) {
+    sendByte(static_cast<uint8_t>(text[i]), Rs);
+  }
+  return len;
+}
+
+size_t Pcf8574Lcd::print(const char* text) {
+  size_t len = 0;
+  while (text && text[len] != '\0') ++len;
+  return write(text, len);
+}
+
+}  // namespace Display
+}  // namespace ArduinoCommon
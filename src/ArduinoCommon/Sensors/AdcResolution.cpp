@@ -0,0 +1,28 @@
+#include <ArduinoCommon/Sensors/AdcResolution.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+uint8_t AdcResolution::currentBits = 10;
+
+uint8_t AdcResolution::useNative() {
+  set(NativeBits);
+  return currentBits;
+}
+
+bool AdcResolution::set(uint8_t bits) {
+  if (bits < 8 || bits > NativeBits) return false;
+
+#if ARDUINOCOMMON_HAS_ANALOG_READ_RESOLUTION
+  analogReadResolution(bits);
+  currentBits = bits;
+  return true;
+#else
+  return bits == currentBits;
+#endif
+}
+
+uint8_t AdcResolution::bits() { return currentBits; }
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
@@ -0,0 +1,100 @@
+#include <ArduinoCommon/Sensors/AdcScanner.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+bool AnalogReadAdcBackend::begin(AdcScanner& scanner, const uint8_t* pins,
+                                 uint8_t count) {
+  if (pins == nullptr || count == 0) return false;
+
+  _scanner = &scanner;
+  _pins = pins;
+  _count = count;
+  _next = 0;
+  return true;
+}
+
+void AnalogReadAdcBackend::poll() {
+  if (_scanner == nullptr || _count == 0) return;
+
+  const int value = analogRead(_pins[_next]);
+  if (value >= 0) {
+    _scanner->push(_next, static_cast<uint16_t>(value));
+  }
+
+  if (++_next >= _count) _next = 0;
+}
+
+void AnalogReadAdcBackend::end() {
+  _scanner = nullptr;
+  _pins = nullptr;
+  _count = 0;
+}
+
+AdcScanner::AdcScanner(IAdcBackend& backend)
+    : _backend(backend), _pins(), _count(0), _running(false) {}
+
+int AdcScanner::addChannel(uint8_t pin) {
+  const int existing = channelForPin(pin);
+  if (existing >= 0) return existing;
+
+  if (_running || _count >= MaxChannels) return -1;
+
+  _pins[_count] = pin;
+  return _count++;
+}
+
+int AdcScanner::channelForPin(uint8_t pin) const {
+  for (uint8_t i = 0; i < _count; ++i) {
+    if (_pins[i] == pin) return i;
+  }
+  return -1;
+}
+
+bool AdcScanner::begin() {
+  if (_running) return true;
+  if (_count == 0) return false;
+
+  _running = _backend.begin(*this, _pins, _count);
+  return _running;
+}
+
+void AdcScanner::end() {
+  if (!_running) return;
+
+  _backend.end();
+  _running = false;
+}
+
+void AdcScanner::update() {
+  if (_running) _backend.poll();
+}
+
+void AdcScanner::push(uint8_t channel, uint16_t value) {
+  if (channel >= _count) return;
+
+  _buffers[channel].push(value);
+}
+
+int AdcScanner::latest(uint8_t channel) const {
+  if (channel >= _count) return -1;
+
+  uint16_t value;
+  if (!_buffers[channel].latest(value)) return -1;
+  return value;
+}
+
+bool AdcScanner::pop(uint8_t channel, uint16_t& value) {
+  if (channel >= _count) return false;
+
+  return _buffers[channel].pop(value);
+}
+
+uint8_t AdcScanner::available(uint8_t channel) const {
+  if (channel >= _count) return 0;
+
+  return _buffers[channel].available();
+}
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
@@ -0,0 +1,141 @@
+#include <ArduinoCommon/Sensors/AutoCalibrator.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+AutoCalibrator::AutoCalibrator(const AutoCalibrationConfig& config)
+    : _config(config) {
+  reset();
+}
+
+void AutoCalibrator::configure(const AutoCalibrationConfig& config) {
+  _config = config;
+}
+
+void AutoCalibrator::reset() {
+  _highQ8 = 0;
+  _lowQ8 = 0;
+  _highCandidateQ8 = 0;
+  _lowCandidateQ8 = 0;
+  _highConfirm = 0;
+  _lowConfirm = 0;
+  _samples = 0;
+  _lastDecayMs = 0;
+  _decayClockStarted = false;
+  _reported = SoilCalibration{};
+}
+
+void AutoCalibrator::seed(const SoilCalibration& calibration) {
+  reset();
+  if (!calibration.isValid()) return;
+
+  const int16_t high = max(calibration.dryRaw, calibration.wetRaw);
+  const int16_t low = min(calibration.dryRaw, calibration.wetRaw);
+  _highQ8 = static_cast<int32_t>(high) << 8;
+  _lowQ8 = static_cast<int32_t>(low) << 8;
+  _samples = _config.minSamples;
+  _reported = calibration;
+}
+
+bool AutoCalibrator::decayDue(uint32_t nowMs) {
+  if (!_decayClockStarted) {
+    _decayClockStarted = true;
+    _lastDecayMs = nowMs;
+    return _config.decayIntervalMs == 0;
+  }
+  if (static_cast<uint32_t>(nowMs - _lastDecayMs) < _config.decayIntervalMs) {
+    return false;
+  }
+  _lastDecayMs = nowMs;
+  return true;
+}
+
+void AutoCalibrator::decayToward(int32_t valueQ8) {
+  const int32_t highQ8 =
+      valueQ8 < _highQ8 ? _highQ8 - ((_highQ8 - valueQ8) >> _config.decayShift)
+                        : _highQ8;
+  const int32_t lowQ8 =
+      valueQ8 > _lowQ8 ? _lowQ8 + ((valueQ8 - _lowQ8) >> _config.decayShift)
+                       : _lowQ8;
+  if (highQ8 - lowQ8 < static_cast<int32_t>(_config.minSpan) << 8) return;
+
+  _highQ8 = highQ8;
+  _lowQ8 = lowQ8;
+}
+
+bool AutoCalibrator::observe(int raw, uint32_t nowMs) {
+  const int maxValid = _config.maxValidRaw < 0 ? 32767 : _config.maxValidRaw;
+  if (raw < _config.minValidRaw || raw > maxValid) {
+    _highConfirm = 0;
+    _lowConfirm = 0;
+    return false;
+  }
+
+  const int32_t valueQ8 = static_cast<int32_t>(raw) << 8;
+
+  if (_samples == 0) {
+    _highQ8 = valueQ8;
+    _lowQ8 = valueQ8;
+    _samples = 1;
+    decayDue(nowMs);
+    return false;
+  }
+  if (_samples < 0xFFFF) ++_samples;
+
+  // New high: require a run of confirmations, accept the run's minimum.
+  if (valueQ8 > _highQ8) {
+    _highCandidateQ8 =
+        _highConfirm == 0 ? valueQ8 : min(_highCandidateQ8, valueQ8);
+    if (++_highConfirm >= _config.confirmSamples) {
+      _highQ8 = _highCandidateQ8;
+      _highConfirm = 0;
+    }
+  } else {
+    _highConfirm = 0;
+  }
+
+  // New low: mirror image of the above.
+  if (valueQ8 < _lowQ8) {
+    _lowCandidateQ8 =
+        _lowConfirm == 0 ? valueQ8 : max(_lowCandidateQ8, valueQ8);
+    if (++_lowConfirm >= _config.confirmSamples) {
+      _lowQ8 = _lowCandidateQ8;
+      _lowConfirm = 0;
+    }
+  } else {
+    _lowConfirm = 0;
+  }
+
+  if (decayDue(nowMs)) decayToward(valueQ8);
+
+  if (!hasCalibration()) return false;
+
+  const SoilCalibration current = calibration();
+  if (current.dryRaw == _reported.dryRaw &&
+      current.wetRaw == _reported.wetRaw) {
+    return false;
+  }
+  _reported = current;
+  return true;
+}
+
+bool AutoCalibrator::hasCalibration() const {
+  if (_samples < _config.minSamples) return false;
+
+  const int32_t span = (_highQ8 - _lowQ8) >> 8;
+  return span >= _config.minSpan && span > 0;
+}
+
+SoilCalibration AutoCalibrator::calibration() const {
+  SoilCalibration result;
+  if (!hasCalibration()) return result;
+
+  const int16_t high = static_cast<int16_t>((_highQ8 + 128) >> 8);
+  const int16_t low = static_cast<int16_t>((_lowQ8 + 128) >> 8);
+  result.dryRaw = _config.dryIsHigh ? high : low;
+  result.wetRaw = _config.dryIsHigh ? low : high;
+  return result;
+}
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
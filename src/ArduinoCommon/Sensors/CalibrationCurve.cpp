@@ -0,0 +1,162 @@
+#include <ArduinoCommon/Sensors/CalibrationCurve.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+CalibrationCurve CalibrationCurve::piecewise(const CalibrationPoint* points,
+                                             uint8_t count) {
+  CalibrationCurve curve;
+  curve.kind = Kind::Piecewise;
+  if (points == nullptr || count > MaxPoints) return curve;
+
+  curve.count = count;
+  uint8_t driest = 0;
+  uint8_t wettest = 0;
+  for (uint8_t i = 0; i < count; ++i) {
+    curve.points[i] = points[i];
+    if (points[i].percent < points[driest].percent) driest = i;
+    if (points[i].percent > points[wettest].percent) wettest = i;
+  }
+  if (count > 0) {
+    curve.dryRaw = points[driest].raw;
+    curve.wetRaw = points[wettest].raw;
+  }
+  return curve;
+}
+
+CalibrationCurve CalibrationCurve::polynomial(const float* coefficients,
+                                              uint8_t count, int16_t dryRaw,
+                                              int16_t wetRaw) {
+  CalibrationCurve curve;
+  curve.kind = Kind::Polynomial;
+  curve.dryRaw = dryRaw;
+  curve.wetRaw = wetRaw;
+  if (coefficients == nullptr || count > MaxCoefficients) return curve;
+
+  curve.count = count;
+  for (uint8_t i = 0; i < count; ++i) curve.coefficients[i] = coefficients[i];
+  return curve;
+}
+
+CalibrationCurve CalibrationCurve::fromLinear(
+    const SoilCalibration& calibration) {
+  // Lower raw maps to 100 %, upper raw to 0 %, as in readPercent().
+  const int16_t lo = min(calibration.dryRaw, calibration.wetRaw);
+  const int16_t hi = max(calibration.dryRaw, calibration.wetRaw);
+  const CalibrationPoint points[2] = {{lo, 100, 0}, {hi, 0, 0}};
+  CalibrationCurve curve = piecewise(points, 2);
+  curve.dryRaw = calibration.dryRaw;
+  curve.wetRaw = calibration.wetRaw;
+  return curve;
+}
+
+bool CalibrationCurve::isValid() const {
+  if (version != Version) return false;
+
+  if (kind == Kind::Piecewise) {
+    if (count < 2 || count > MaxPoints) return false;
+    for (uint8_t i = 0; i < count; ++i) {
+      if (points[i].raw < 0 || points[i].percent > 100) return false;
+      if (i > 0 && points[i].raw <= points[i - 1].raw) return false;
+    }
+    return true;
+  }
+
+  if (kind == Kind::Polynomial) {
+    return count >= 1 && count <= MaxCoefficients && dryRaw >= 0 &&
+           wetRaw >= 0 && dryRaw != wetRaw;
+  }
+
+  return false;
+}
+
+int16_t CalibrationCurve::minRaw() const {
+  if (kind == Kind::Piecewise) return points[0].raw;
+  return min(dryRaw, wetRaw);
+}
+
+int16_t CalibrationCurve::maxRaw() const {
+  if (kind == Kind::Piecewise) return points[count - 1].raw;
+  return max(dryRaw, wetRaw);
+}
+
+float CalibrationCurve::evaluate(int32_t raw, bool clampRaw) const {
+  if (clampRaw) {
+    if (raw < minRaw()) raw = minRaw();
+    if (raw > maxRaw()) raw = maxRaw();
+  }
+
+  float result = 0.0f;
+  if (kind == Kind::Piecewise) {
+    uint8_t i = 1;
+    while (i < count - 1 && raw > points[i].raw) ++i;
+    const CalibrationPoint& a = points[i - 1];
+    const CalibrationPoint& b = points[i];
+    const float t = static_cast<float>(raw - a.raw) / (b.raw - a.raw);
+    result = a.percent + t * (static_cast<float>(b.percent) - a.percent);
+  } else {
+    const float x = static_cast<float>(raw);
+    for (int8_t c = static_cast<int8_t>(count) - 1; c >= 0; --c) {
+      result = result * x + coefficients[c];
+    }
+  }
+
+  if (result < 0.0f) result = 0.0f;
+  if (result > 100.0f) result = 100.0f;
+  return result;
+}
+
+bool CalibrationLut::build(const CalibrationCurve& curve) {
+  _valid = false;
+  if (!curve.isValid()) return false;
+
+  _lo = curve.minRaw();
+  _hi = curve.maxRaw();
+  _segmentCount = 0;
+  if (curve.kind == CalibrationCurve::Kind::Piecewise) {
+    buildSegments(curve);
+  } else {
+    buildTable(curve);
+  }
+  _loPercent = static_cast<uint8_t>(curve.evaluate(_lo) + 0.5f);
+  _hiPercent = static_cast<uint8_t>(curve.evaluate(_hi) + 0.5f);
+
+  _valid = true;
+  return true;
+}
+
+void CalibrationLut::buildSegments(const CalibrationCurve& curve) {
+  // One segment per pair of breakpoints. |slope| * width stays below
+  // 12800 << SlopeShift, so toPercent() cannot overflow 32 bits.
+  _segmentCount = static_cast<uint8_t>(curve.count - 1);
+  for (uint8_t i = 0; i < _segmentCount; ++i) {
+    const CalibrationPoint& a = curve.points[i];
+    const CalibrationPoint& b = curve.points[i + 1];
+    const int32_t rise =
+        (static_cast<int32_t>(b.percent) - a.percent) * 128;
+    _segments[i].raw = a.raw;
+    _segments[i].q7 = static_cast<int16_t>(a.percent * 128);
+    _segments[i].slope =
+        (rise * (static_cast<int32_t>(1) << SlopeShift)) / (b.raw - a.raw);
+  }
+}
+
+void CalibrationLut::buildTable(const CalibrationCurve& curve) {
+  const uint16_t range = static_cast<uint16_t>(_hi - _lo);
+
+  // Smallest bucket width (2^shift) whose entries fit the table.
+  _shift = 0;
+  while ((((range + (1u << _shift) - 1) >> _shift) + 1) > Size) ++_shift;
+  _last = static_cast<uint8_t>((range + (1u << _shift) - 1) >> _shift);
+
+  // The last bucket may reach past _hi; extrapolate there so that
+  // interpolation inside that bucket stays on the curve.
+  for (uint8_t i = 0; i <= _last; ++i) {
+    const int32_t raw = _lo + (static_cast<int32_t>(i) << _shift);
+    const float percent = curve.evaluate(raw, false);
+    _table[i] = static_cast<uint16_t>(percent * 128.0f + 0.5f);
+  }
+}
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
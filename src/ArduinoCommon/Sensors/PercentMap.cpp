@@ -0,0 +1,36 @@
+#include <ArduinoCommon/Sensors/PercentMap.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+PercentMap PercentMap::fromCalibration(int16_t dryRaw, int16_t wetRaw) {
+  PercentMap result;
+  if (dryRaw < 0 || wetRaw < 0 || dryRaw == wetRaw) return result;
+
+  result.lo = dryRaw < wetRaw ? dryRaw : wetRaw;
+  result.hi = dryRaw < wetRaw ? wetRaw : dryRaw;
+  computeScale(static_cast<uint16_t>(result.hi - result.lo), result.scale,
+               result.shift);
+  result.valid = true;
+  return result;
+}
+
+void PercentMap::computeScale(uint16_t range, uint32_t& scale,
+                              uint8_t& shift) {
+  if (range == 0) {
+    scale = 0;
+    shift = 0;
+    return;
+  }
+
+  // Smallest shift with 2^shift >= range^2 (at most 30 for 15-bit ranges).
+  const uint32_t squared = static_cast<uint32_t>(range) * range;
+  shift = 0;
+  while ((static_cast<uint32_t>(1) << shift) < squared) ++shift;
+
+  const uint64_t numerator = static_cast<uint64_t>(100) << shift;
+  scale = static_cast<uint32_t>((numerator + range - 1) / range);
+}
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
@@ -0,0 +1,97 @@
+#include <ArduinoCommon/Sensors/SensorWatch.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+int8_t WatchList::add(Kind kind, WatchSource source, int16_t limit,
+                      int16_t margin, WatchCallback callback, void* context) {
+  if (callback == nullptr) return -1;
+
+  for (uint8_t i = 0; i < MaxWatches; ++i) {
+    if (_watches[i].kind != Kind::Unused) continue;
+
+    Watch& watch = _watches[i];
+    watch = Watch{};
+    watch.kind = kind;
+    watch.source = source;
+    watch.limit = limit;
+    watch.margin = margin;
+    watch.callback = callback;
+    watch.context = context;
+    return static_cast<int8_t>(i);
+  }
+  return -1;
+}
+
+int8_t WatchList::addThreshold(WatchSource source, int16_t threshold,
+                               int16_t hysteresis, WatchCallback callback,
+                               void* context) {
+  if (hysteresis < 0) hysteresis = 0;
+  return add(Kind::Threshold, source, threshold, hysteresis, callback,
+             context);
+}
+
+int8_t WatchList::addDeadband(WatchSource source, int16_t deadband,
+                              WatchCallback callback, void* context) {
+  if (deadband < 0) deadband = 0;
+  return add(Kind::Deadband, source, deadband, 0, callback, context);
+}
+
+bool WatchList::remove(int8_t id) {
+  if (id < 0 || id >= MaxWatches) return false;
+  if (_watches[id].kind == Kind::Unused) return false;
+
+  _watches[id] = Watch{};
+  return true;
+}
+
+void WatchList::clear() {
+  for (uint8_t i = 0; i < MaxWatches; ++i) _watches[i] = Watch{};
+}
+
+bool WatchList::empty() const {
+  for (uint8_t i = 0; i < MaxWatches; ++i) {
+    if (_watches[i].kind != Kind::Unused) return false;
+  }
+  return true;
+}
+
+void WatchList::evaluate(IAnalogSensor& sensor, int raw, int percent) {
+  for (uint8_t i = 0; i < MaxWatches; ++i) {
+    Watch& watch = _watches[i];
+    if (watch.kind == Kind::Unused) continue;
+
+    const int value = watch.source == WatchSource::Percent ? percent : raw;
+    if (value < 0) continue;
+
+    SensorEvent event{WatchEvent::Changed, static_cast<int8_t>(i),
+                      static_cast<int16_t>(value)};
+
+    if (watch.kind == Kind::Threshold) {
+      State next = watch.state;
+      if (value < watch.limit) {
+        next = State::Below;
+      } else if (value >= watch.limit + watch.margin ||
+                 watch.state == State::Unknown) {
+        next = State::Above;
+      }
+      if (next == watch.state) continue;
+
+      watch.state = next;
+      event.type = next == State::Below ? WatchEvent::Below : WatchEvent::Above;
+    } else {
+      const int delta = value - watch.last;
+      if (watch.state != State::Unknown &&
+          delta <= watch.limit && -delta <= watch.limit) {
+        continue;
+      }
+      watch.state = State::Above;  // marks "has reported"
+      watch.last = static_cast<int16_t>(value);
+    }
+
+    watch.callback(sensor, event, watch.context);
+  }
+}
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
@@ -1,4 +1,4 @@
-#include "ArduinoCommon/Sensors/SoilSensor.h"
+#include "ArduinoCommon/Sensors/SOILSENSOR.h"
 
 namespace ArduinoCommon {
 namespace Sensors {
@@ -9,16 +9,73 @@ SoilSensor::SoilSensor(uint8_t pin)
     : _inputPin(pin),
       _validConfig(false),
       _calibration(),
+      _percentMap(),
+      _curveLut(),
       _storage(nullptr),
-      _storageKey(0) {}
+      _storageKey(0),
+      _slotSize(0),
+      _storageError(false),
+      _legacyFormat(false),
+      _scanner(nullptr),
+      _scanChannel(-1),
+      _oversampleBits(0),
+      _decimateCount(0),
+      _decimateTotal(0),
+      _autoCalibrator(),
+      _autoCalibrating(false),
+      _hasPersisted(false),
+      _lastPersistMs(0),
+      _persisted(),
+      _seededSpan(0),
+      _watches(),
+      _sampleTarget(0),
+      _sampleCount(0),
+      _sampleIntervalMs(0),
+      _lastSampleMs(0),
+      _sampleTotal(0),
+      _sampledRaw(-1),
+      _sampling(false) {}
+
+bool SoilSensor::attachStorage(Config::IConfigStorage* storage, uint16_t key,
+                               uint16_t slotSize) {
+  _storage = nullptr;
+  _storageError = false;
+  _hasPersisted = false;
+  if (storage == nullptr) return true;
+
+  if (slotSize < sizeof(SoilCalibration) ||
+      static_cast<uint32_t>(key) + slotSize > 0x10000UL) {
+    Serial.print(F("Error: invalid calibration slot at storage key "));
+    Serial.println(key);
+    _storageError = true;
+    _validConfig = false;
+    return false;
+  }
 
-void SoilSensor::attachStorage(Config::IConfigStorage* storage, uint16_t key) {
   _storage = storage;
   _storageKey = key;
+  _slotSize = slotSize;
+  _legacyFormat = slotSize < StorageSize;
+  return true;
+}
+
+bool SoilSensor::attachScanner(AdcScanner* scanner) {
+  if (scanner == nullptr) {
+    _scanner = nullptr;
+    _scanChannel = -1;
+    return true;
+  }
+
+  const int channel = scanner->addChannel(_inputPin);
+  if (channel < 0) return false;
+
+  _scanner = scanner;
+  _scanChannel = static_cast<int8_t>(channel);
+  return true;
 }
 
 bool SoilSensor::begin(int16_t dryCalibration, int16_t wetCalibration) {
-  if (!PinManager::reservePin(_inputPin)) {
+  if (_storageError || !PinManager::reservePin(_inputPin)) {
     _validConfig = false;
     return false;
   }
@@ -28,9 +85,11 @@ bool SoilSensor::begin(int16_t dryCalibration, int16_t wetCalibration) {
   // If the user provides calibration values, use them.
   if (dryCalibration >= 0 && wetCalibration >= 0 &&
       wetCalibration != dryCalibration) {
-    _calibration.dryRaw = dryCalibration;
-    _calibration.wetRaw = wetCalibration;
-    _calibration.version = 1;
+    SoilCalibration calibration;
+    calibration.dryRaw = dryCalibration;
+    calibration.wetRaw = wetCalibration;
+    calibration.version = 1;
+    applyCalibration(calibration);
 
     saveCalibrationToStorage();
     return true;
@@ -40,25 +99,95 @@ bool SoilSensor::begin(int16_t dryCalibration, int16_t wetCalibration) {
     return true;
   }
 
-  _calibration = SoilCalibration{};
+  applyCalibration(SoilCalibration{});
   return true;
 }
 
 bool SoilSensor::validConfiguration() const { return _validConfig; }
 
+bool SoilSensor::enableAutoCalibration(const AutoCalibrationConfig& config) {
+  if (_curveLut.valid()) return false;
+
+  AutoCalibrationConfig resolved = config;
+  if (resolved.maxValidRaw < 0) {
+    resolved.maxValidRaw = static_cast<int16_t>(
+        AdcResolution::maxValue(resolutionBits()) - 1);
+  }
+
+  _autoCalibrator.configure(resolved);
+  _autoCalibrator.seed(_calibration);
+  _seededSpan = _calibration.isValid()
+                    ? static_cast<int16_t>(
+                          abs(_calibration.dryRaw - _calibration.wetRaw))
+                    : 0;
+  _autoCalibrating = true;
+  return true;
+}
+
+void SoilSensor::disableAutoCalibration() { _autoCalibrating = false; }
+
+bool SoilSensor::autoCalibrationEnabled() const { return _autoCalibrating; }
+
+void SoilSensor::updateAutoCalibration(int raw) {
+  if (_autoCalibrator.observe(raw)) {
+    applyCalibration(_autoCalibrator.calibration());
+  }
+  persistLearnedCalibration();
+}
+
+void SoilSensor::persistLearnedCalibration() {
+  if (!_storage || !_calibration.isValid()) return;
+  if (abs(_calibration.dryRaw - _calibration.wetRaw) < _seededSpan) return;
+
+  const AutoCalibrationConfig& config = _autoCalibrator.config();
+  const uint32_t now = millis();
+  if (_hasPersisted) {
+    const int dryDrift = abs(_calibration.dryRaw - _persisted.dryRaw);
+    const int wetDrift = abs(_calibration.wetRaw - _persisted.wetRaw);
+    if (dryDrift <= config.persistThreshold &&
+        wetDrift <= config.persistThreshold) {
+      return;
+    }
+    if (static_cast<uint32_t>(now - _lastPersistMs) <
+        config.persistIntervalMs) {
+      return;
+    }
+  }
+
+  saveCalibrationToStorage();
+}
+
 bool SoilSensor::hasCalibration() const { return _calibration.isValid(); }
 
-void SoilSensor::clearCalibration() {
-  _calibration = SoilCalibration{};
-  if (_storage) {
-    _storage->clear(_storageKey, sizeof(SoilCalibration));
+bool SoilSensor::clearCalibration() {
+  applyCalibration(SoilCalibration{});
+  _hasPersisted = false;
+  if (_autoCalibrating) _autoCalibrator.reset();
+  if (!_storage) return true;
+
+  Config::RecordHeader header;
+  if (_legacyFormat || !_storage->read(_storageKey, &header, sizeof(header)) ||
+      header.magic != Config::ConfigRecord::Magic) {
+    return _storage->clear(_storageKey, sizeof(SoilCalibration));
   }
+
+  // Erase the header first so an interrupted clear reads as empty, then
+  // the payload, bounded by the slot in case the length is corrupt.
+  const uint16_t maxPayload = _slotSize - Config::ConfigRecord::HeaderSize;
+  const uint16_t payload =
+      header.length < maxPayload ? header.length : maxPayload;
+  return Config::ConfigRecord::erase(*_storage, _storageKey) &&
+         (payload == 0 ||
+          _storage->clear(_storageKey + Config::ConfigRecord::HeaderSize,
+                          payload));
 }
 
 void SoilSensor::setCalibration(int16_t dryRaw, int16_t wetRaw, bool persist) {
-  _calibration.dryRaw = dryRaw;
-  _calibration.wetRaw = wetRaw;
-  _calibration.version = 1;
+  SoilCalibration calibration;
+  calibration.dryRaw = dryRaw;
+  calibration.wetRaw = wetRaw;
+  calibration.version = 1;
+  applyCalibration(calibration);
 
   if (persist) {
     saveCalibrationToStorage();
@@ -67,9 +196,120 @@ void SoilSensor::setCalibration(int16_t dryRaw, int16_t wetRaw, bool persist) {
 
 SoilCalibration SoilSensor::getCalibration() const { return _calibration; }
 
+bool SoilSensor::setCalibrationCurve(const CalibrationCurve& curve,
+                                     bool persist) {
+  if (!curve.isValid()) return false;
+
+  SoilCalibration endpoints;
+  endpoints.dryRaw = curve.dryRaw;
+  endpoints.wetRaw = curve.wetRaw;
+  endpoints.version = CalibrationCurve::Version;
+  applyCalibration(endpoints);
+  _curveLut.build(curve);
+  _autoCalibrating = false;
+
+  if (!persist || !_storage) return true;
+  if (_slotSize < CurveStorageSize) {
+    Serial.print(F("Error: storage slot at key "));
+    Serial.print(_storageKey);
+    Serial.println(F(" is too small for a calibration curve"));
+    return true;
+  }
+  if (Config::ConfigRecord::write(*_storage, _storageKey,
+                                  CalibrationRecordType, curve.version, &curve,
+                                  sizeof(CalibrationCurve))) {
+    _legacyFormat = false;
+    _persisted = _calibration;
+    _hasPersisted = true;
+    _lastPersistMs = millis();
+  }
+  return true;
+}
+
+bool SoilSensor::hasCalibrationCurve() const { return _curveLut.valid(); }
+
+void SoilSensor::applyCalibration(const SoilCalibration& calibration) {
+  _curveLut.clear();
+  _calibration = calibration;
+  _percentMap = calibration.isValid()
+                    ? PercentMap::fromCalibration(calibration.dryRaw,
+                                                  calibration.wetRaw)
+                    : PercentMap{};
+}
+
+bool SoilSensor::setOversampling(uint8_t extraBits, bool rescaleCalibration) {
+  if (AdcResolution::bits() + extraBits > 15) return false;
+
+  const int8_t delta =
+      static_cast<int8_t>(extraBits) - static_cast<int8_t>(_oversampleBits);
+  if (rescaleCalibration && delta != 0 && _curveLut.valid()) return false;
+  _oversampleBits = extraBits;
+  _decimateCount = 0;
+  _decimateTotal = 0;
+
+  if (rescaleCalibration && delta != 0 && _calibration.isValid()) {
+    SoilCalibration scaled = _calibration;
+    if (delta > 0) {
+      scaled.dryRaw = static_cast<int16_t>(scaled.dryRaw << delta);
+      scaled.wetRaw = static_cast<int16_t>(scaled.wetRaw << delta);
+    } else {
+      scaled.dryRaw = static_cast<int16_t>(scaled.dryRaw >> -delta);
+      scaled.wetRaw = static_cast<int16_t>(scaled.wetRaw >> -delta);
+    }
+    applyCalibration(scaled);
+  }
+  return true;
+}
+
+uint8_t SoilSensor::oversamplingBits() const { return _oversampleBits; }
+
+uint8_t SoilSensor::resolutionBits() const {
+  return AdcResolution::bits() + _oversampleBits;
+}
+
 int SoilSensor::readRaw() const {
   if (!_validConfig) return -1;
 
+  return readDecimated();
+}
+
+int SoilSensor::readDecimated() const {
+  if (_oversampleBits == 0) return readAdc();
+
+  if (_scanner) {
+    const int value = readAdc();
+    return value < 0 ? value : value << _oversampleBits;
+  }
+
+  const uint16_t conversions = static_cast<uint16_t>(1)
+                               << (2 * _oversampleBits);
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < conversions; ++i) {
+    total += static_cast<uint16_t>(analogRead(_inputPin));
+  }
+  return static_cast<int>(total >> _oversampleBits);
+}
+
+bool SoilSensor::takeSample(int& value) {
+  if (_oversampleBits == 0 || _scanner) {
+    value = readDecimated();
+    return value >= 0;  // a scanner may have no conversion yet
+  }
+
+  _decimateTotal += static_cast<uint16_t>(analogRead(_inputPin));
+  const uint16_t conversions = static_cast<uint16_t>(1)
+                               << (2 * _oversampleBits);
+  if (++_decimateCount < conversions) return false;
+
+  value = static_cast<int>(_decimateTotal >> _oversampleBits);
+  _decimateCount = 0;
+  _decimateTotal = 0;
+  return true;
+}
+
+int SoilSensor::readAdc() const {
+  if (_scanner) return _scanner->latest(_scanChannel);
+
   return analogRead(_inputPin);
 }
 
@@ -82,28 +322,21 @@ int SoilSensor::readPercent() const {
     return 0;
   }
 
-  if (!_calibration.isValid()) {
-    return map(raw, 0, 1023, 0, 100);
-  }
-
-  int16_t minVal = _calibration.wetRaw;
-  int16_t maxVal = _calibration.dryRaw;
+  return rawToPercent(raw);
+}
 
-  if (minVal > maxVal) {
-    int16_t tmp = minVal;
-    minVal = maxVal;
-    maxVal = tmp;
+int SoilSensor::rawToPercent(int raw) const {
+  if (_curveLut.valid()) {
+    return _curveLut.toPercent(raw);
   }
 
-  int16_t clamped = raw;
-  if (clamped < minVal) clamped = minVal;
-  if (clamped > maxVal) clamped = maxVal;
-
-  int percent = map(clamped, minVal, maxVal, 100, 0);
+  if (!_percentMap.valid) {
+    return map(raw, 0, AdcResolution::maxValue(resolutionBits()), 0, 100);
+  }
 
-  if (percent < 0) percent = 0;
-  if (percent > 100) percent = 100;
-  return percent;
+  // Same result as the clamped map(raw, min, max, 100, 0), without the
+  // per-call division.
+  return _percentMap.toPercent(raw);
 }
 
 int SoilSensor::readAveragedRaw(uint8_t samples) const {
@@ -111,39 +344,160 @@ int SoilSensor::readAveragedRaw(uint8_t samples) const {
 
   long total = 0;
   for (uint8_t i = 0; i < samples; i++) {
-    total += static_cast<int16_t>(analogRead(_inputPin));
+    const int value = readDecimated();
+    if (value < 0) return -1;
+    total += value;
     delay(10);  // small delay between samples to reduce noise
   }
   return static_cast<int>(total / samples);
 }
 
+bool SoilSensor::startSampling(uint8_t samples, uint16_t intervalMs) {
+  if (!_validConfig || samples == 0) return false;
+
+  _sampleTarget = samples;
+  _sampleCount = 0;
+  _sampleIntervalMs = intervalMs;
+  _sampleTotal = 0;
+  _sampledRaw = -1;
+  _decimateCount = 0;
+  _decimateTotal = 0;
+  _sampling = true;
+  return true;
+}
+
+void SoilSensor::update() {
+  if (!_sampling) return;
+
+  const uint32_t now = millis();
+  if (_sampleCount > 0 && _decimateCount == 0 &&
+      static_cast<uint32_t>(now - _lastSampleMs) < _sampleIntervalMs) {
+    return;
+  }
+
+  int value;
+  if (!takeSample(value)) return;  // more conversions to go, or no data
+
+  _sampleTotal += value;
+  _lastSampleMs = now;
+
+  if (++_sampleCount >= _sampleTarget) {
+    _sampledRaw = static_cast<int>(_sampleTotal / _sampleTarget);
+    _sampling = false;
+    if (_autoCalibrating) updateAutoCalibration(_sampledRaw);
+    _watches.evaluate(*this, _sampledRaw, rawToPercent(_sampledRaw));
+  }
+}
+
+int8_t SoilSensor::addThresholdWatch(WatchSource source, int16_t threshold,
+                                     int16_t hysteresis,
+                                     WatchCallback callback, void* context) {
+  return _watches.addThreshold(source, threshold, hysteresis, callback,
+                               context);
+}
+
+int8_t SoilSensor::addDeadbandWatch(WatchSource source, int16_t deadband,
+                                    WatchCallback callback, void* context) {
+  return _watches.addDeadband(source, deadband, callback, context);
+}
+
+bool SoilSensor::removeWatch(int8_t id) { return _watches.remove(id); }
+
+bool SoilSensor::isSampling() const { return _sampling; }
+
+bool SoilSensor::isReady() const { return !_sampling && _sampledRaw >= 0; }
+
+int SoilSensor::sampledRaw() const { return _sampledRaw; }
+
+int SoilSensor::sampledPercent() const {
+  if (_sampledRaw < 0) return -1;
+  return rawToPercent(_sampledRaw);
+}
+
 bool SoilSensor::loadCalibrationFromStorage() {
   if (!_storage) {
     return false;
   }
 
-  if (!_storage->isUsed(_storageKey, sizeof(SoilCalibration))) {
+  // Large enough for either payload version.
+  uint8_t payload[sizeof(CalibrationCurve)];
+  Config::ConfigRecord::Info info;
+  const Config::RecordStatus status = Config::ConfigRecord::read(
+      *_storage, _storageKey, CalibrationRecordType, payload, sizeof(payload),
+      &info);
+
+  if (status != Config::RecordStatus::Ok) {
+    return status == Config::RecordStatus::Corrupt &&
+           loadLegacyCalibration();
+  }
+
+  if (info.version == CalibrationCurve::Version &&
+      info.length == sizeof(CalibrationCurve)) {
+    CalibrationCurve curve;
+    memcpy(&curve, payload, sizeof(CalibrationCurve));
+    if (!setCalibrationCurve(curve, false)) return false;
+  } else if (info.version == 1 && info.length == sizeof(SoilCalibration)) {
+    SoilCalibration tmp;
+    memcpy(&tmp, payload, sizeof(SoilCalibration));
+    if (tmp.version != 1 || !tmp.isValid()) return false;
+    applyCalibration(tmp);
+  } else {
     return false;
   }
 
+  _persisted = _calibration;
+  _hasPersisted = true;
+  _lastPersistMs = millis();
+  return true;
+}
+
+bool SoilSensor::loadLegacyCalibration() {
+  // Unframed SoilCalibration written before records had headers. A
+  // framed record whose CRC failed is not reinterpreted.
+  uint16_t magic;
   SoilCalibration tmp;
-  if (!_storage->read(_storageKey, &tmp, sizeof(SoilCalibration))) {
+  if (!_storage->read(_storageKey, &magic, sizeof(magic)) ||
+      magic == Config::ConfigRecord::Magic ||
+      !_storage->read(_storageKey, &tmp, sizeof(SoilCalibration))) {
     return false;
   }
 
-  if (!tmp.isValid()) {
+  if (tmp.version != 1 || !tmp.isValid()) {
     return false;
   }
 
-  _calibration = tmp;
+  applyCalibration(tmp);
+  _legacyFormat = true;
+  _persisted = tmp;
+  _hasPersisted = true;
+  _lastPersistMs = millis();
   return true;
 }
 
-bool SoilSensor::saveCalibrationToStorage() const {
+bool SoilSensor::saveCalibrationToStorage() {
   if (!_storage || !_calibration.isValid()) {
     return false;
   }
-  return _storage->write(_storageKey, &_calibration, sizeof(SoilCalibration));
+
+  if (_hasPersisted && _persisted.dryRaw == _calibration.dryRaw &&
+      _persisted.wetRaw == _calibration.wetRaw &&
+      _persisted.version == _calibration.version) {
+    return true;
+  }
+
+  const bool written =
+      _legacyFormat
+          ? _storage->write(_storageKey, &_calibration, sizeof(SoilCalibration))
+          : Config::ConfigRecord::writeValue(*_storage, _storageKey,
+                                             CalibrationRecordType,
+                                             _calibration.version,
+                                             _calibration);
+  if (!written) return false;
+
+  _persisted = _calibration;
+  _hasPersisted = true;
+  _lastPersistMs = millis();
+  return true;
 }
 
 }  // namespace Sensors
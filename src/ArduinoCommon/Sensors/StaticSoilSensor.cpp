@@ -0,0 +1,37 @@
+#include <ArduinoCommon/Sensors/StaticSoilSensor.h>
+#include <ArduinoCommon/Utils/PinManager.h>
+
+namespace ArduinoCommon {
+namespace Sensors {
+
+using ArduinoCommon::Utils::PinManager;
+
+bool StaticSoilSensor::begin(int16_t dryCalibration, int16_t wetCalibration) {
+  if (!_validConfig) {
+    if (!PinManager::reservePin(_inputPin)) return false;
+    pinMode(_inputPin, INPUT);
+    _validConfig = true;
+  }
+
+  setCalibration(dryCalibration, wetCalibration);
+  return true;
+}
+
+void StaticSoilSensor::end() {
+  if (!_validConfig) return;
+
+  PinManager::releasePin(_inputPin);
+  _validConfig = false;
+}
+
+void StaticSoilSensor::setCalibration(int16_t dryRaw, int16_t wetRaw) {
+  _calibration.dryRaw = dryRaw;
+  _calibration.wetRaw = wetRaw;
+  _calibration.version = 1;
+  _percentMap = _calibration.isValid()
+                    ? PercentMap::fromCalibration(dryRaw, wetRaw)
+                    : PercentMap{};
+}
+
+}  // namespace Sensors
+}  // namespace ArduinoCommon
@@ -0,0 +1,68 @@
+#include <Arduino.h>
+#include <ArduinoCommon/Utils/I2cBusManager.h>
+#include <ArduinoCommon/Utils/PinManager.h>
+
+namespace ArduinoCommon {
+namespace Utils {
+
+I2cBusManager::Bus I2cBusManager::buses[MaxBuses] = {};
+
+I2cBusManager::Bus* I2cBusManager::find(uint8_t sda, uint8_t scl) {
+  for (uint8_t i = 0; i < MaxBuses; ++i) {
+    Bus& bus = buses[i];
+    if (bus.users > 0 && bus.sda == sda && bus.scl == scl) return &bus;
+  }
+  return nullptr;
+}
+
+bool I2cBusManager::acquire(uint8_t sda, uint8_t scl,
+                            const void* controller) {
+  Bus* bus = find(sda, scl);
+  if (bus) {
+    if (bus->controller != controller || bus->users == 0xFF) return false;
+    ++bus->users;
+    return true;
+  }
+
+  Bus* slot = nullptr;
+  for (uint8_t i = 0; i < MaxBuses; ++i) {
+    if (buses[i].users == 0) {
+      if (!slot) slot = &buses[i];
+    } else if (controller && buses[i].controller == controller) {
+      return false;  // already driving another pin pair
+    }
+  }
+  if (!slot) return false;
+
+  const bool sdaOk = PinManager::reservePin(sda);
+  const bool sclOk = PinManager::reservePin(scl);
+  if (!sdaOk || !sclOk) {
+    if (sdaOk) PinManager::releasePin(sda);
+    if (sclOk) PinManager::releasePin(scl);
+    return false;
+  }
+
+  slot->sda = sda;
+  slot->scl = scl;
+  slot->users = 1;
+  slot->controller = controller;
+  return true;
+}
+
+void I2cBusManager::release(uint8_t sda, uint8_t scl) {
+  Bus* bus = find(sda, scl);
+  if (!bus) return;
+
+  if (--bus->users == 0) {
+    PinManager::releasePin(sda);
+    PinManager::releasePin(scl);
+  }
+}
+
+uint8_t I2cBusManager::userCount(uint8_t sda, uint8_t scl) {
+  const Bus* bus = find(sda, scl);
+  return bus ? bus->users : 0;
+}
+
+}  // namespace Utils
+}  // namespace ArduinoCommon
@@ -0,0 +1,152 @@
+// Host benchmark for EepromStorage's RAM-buffer path (ESP32/ESP8266),
+// run with `pio test -e native -f test_Benchmarks`.
+//
+// Compares the block transfers against the byte loops EepromStorage used
+// before, on the native EEPROM fake. The EEPROM accesses and commits of
+// each are deterministic and asserted; wall-clock throughput depends on
+// the host and is only printed.
+
+// Build the RAM-buffer path the ESP cores use; nothing else in this test
+// includes EepromStorage.h.
+#define ARDUINOCOMMON_EEPROM_NEEDS_COMMIT 1
+#define ARDUINOCOMMON_EEPROM_HAS_DATA_PTR 1
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include <chrono>
+
+#include <ArduinoCommon/Config/EepromStorage.h>
+
+using ArduinoCommon::Config::EepromStorage;
+
+namespace {
+
+const size_t Block = 64;
+const uint32_t Rounds = 20000;
+
+uint8_t buffer[Block];
+volatile bool sink = false;
+
+// The loops EepromStorage ran before it had block paths.
+void bytewiseRead() {
+  for (size_t i = 0; i < Block; ++i) buffer[i] = EEPROM.read(i);
+}
+
+void bytewiseWrite() {
+  for (size_t i = 0; i < Block; ++i) EEPROM.update(i, buffer[i]);
+  EEPROM.commit();
+}
+
+bool bytewiseIsUsed() {
+  for (size_t i = 0; i < Block; ++i) {
+    if (EEPROM.read(i) != 0xFF) return true;
+  }
+  return false;
+}
+
+struct Run {
+  uint32_t reads;
+  uint32_t writes;
+  uint32_t commits;
+  double bytesPerUs;
+};
+
+template <typename Fn>
+Run measure(Fn fn) {
+  EEPROM.resetCounters();
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < Rounds; ++r) fn();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  Run run;
+  run.reads = EEPROM.reads / Rounds;
+  run.writes = EEPROM.writes / Rounds;
+  run.commits = EEPROM.commits / Rounds;
+  const double us =
+      std::chrono::duration<double, std::micro>(elapsed).count();
+  run.bytesPerUs = us > 0 ? static_cast<double>(Block) * Rounds / us : 0;
+  return run;
+}
+
+void report(const char* name, const Run& before, const Run& after) {
+  char line[160];
+  snprintf(line, sizeof(line),
+           "%-18s per call: before %2lu reads %2lu writes %lu commits, "
+           "after %2lu/%2lu/%lu; %.0f -> %.0f B/us",
+           name, static_cast<unsigned long>(before.reads),
+           static_cast<unsigned long>(before.writes),
+           static_cast<unsigned long>(before.commits),
+           static_cast<unsigned long>(after.reads),
+           static_cast<unsigned long>(after.writes),
+           static_cast<unsigned long>(after.commits), before.bytesPerUs,
+           after.bytesPerUs);
+  TEST_MESSAGE(line);
+}
+
+}  // namespace
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_benchmark_read(void) {
+  EepromStorage storage(Block);
+  const Run before = measure([] { bytewiseRead(); });
+  const Run after = measure([&] { storage.read(0, buffer, Block); });
+  report("read", before, after);
+  TEST_ASSERT_EQUAL(Block, before.reads);
+  TEST_ASSERT_EQUAL(0, after.reads);
+}
+
+void test_benchmark_unchanged_write(void) {
+  // Unchanged data: measures the compare cost, not EEPROM wear.
+  EepromStorage storage(Block);
+  TEST_ASSERT_TRUE(storage.clear(0, Block));
+  memset(buffer, 0xFF, sizeof(buffer));
+
+  const Run before = measure([] { bytewiseWrite(); });
+  const Run after = measure([&] { storage.write(0, buffer, Block); });
+  report("write (unchanged)", before, after);
+  TEST_ASSERT_EQUAL(Block, before.writes);
+  TEST_ASSERT_EQUAL(1, before.commits);
+  TEST_ASSERT_EQUAL(0, after.writes);
+  TEST_ASSERT_EQUAL(0, after.commits);
+}
+
+void test_benchmark_is_used(void) {
+  EepromStorage storage(Block);
+  TEST_ASSERT_TRUE(storage.clear(0, Block));
+
+  const Run before = measure([] { sink = bytewiseIsUsed(); });
+  const Run after = measure([&] { sink = storage.isUsed(0, Block); });
+  report("isUsed", before, after);
+  TEST_ASSERT_FALSE(sink);
+  TEST_ASSERT_EQUAL(Block, before.reads);
+  TEST_ASSERT_EQUAL(0, after.reads);
+}
+
+void test_benchmark_changed_write_commits_once(void) {
+  EepromStorage storage(Block);
+  EEPROM.resetCounters();
+  for (uint8_t i = 0; i < Block; ++i) buffer[i] = i;
+  TEST_ASSERT_TRUE(storage.write(0, buffer, Block));
+  TEST_ASSERT_EQUAL(1, EEPROM.commits);
+
+  uint8_t back[Block];
+  TEST_ASSERT_TRUE(storage.read(0, back, Block));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer, back, Block);
+}
+
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+  RUN_TEST(test_benchmark_read);
+  RUN_TEST(test_benchmark_unchanged_write);
+  RUN_TEST(test_benchmark_is_used);
+  RUN_TEST(test_benchmark_changed_write_commits_once);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,805 @@
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "FakeConfigStorage.h"
+#include <ArduinoCommon/Config/AtomicStorage.h>
+#include <ArduinoCommon/Config/CachedStorage.h>
+#include <ArduinoCommon/Config/ConfigLayout.h>
+#include <ArduinoCommon/Config/ConfigRecord.h>
+#include <ArduinoCommon/Config/ConfigStore.h>
+#include <ArduinoCommon/Config/Crc16.h>
+#include <ArduinoCommon/Config/EepromStorage.h>
+#include <ArduinoCommon/Config/InstrumentedStorage.h>
+#include <ArduinoCommon/Config/MmapFileStorage.h>
+#include <ArduinoCommon/Config/RamStorage.h>
+#include <ArduinoCommon/Config/WearLeveledStorage.h>
+
+using ArduinoCommon::Config::AtomicStorage;
+using ArduinoCommon::Config::CachedStorage;
+using ArduinoCommon::Config::ConfigBytes;
+using ArduinoCommon::Config::ConfigKey;
+using ArduinoCommon::Config::ConfigLayout;
+using ArduinoCommon::Config::ConfigRecord;
+using ArduinoCommon::Config::ConfigStore;
+using ArduinoCommon::Config::Crc16;
+using ArduinoCommon::Config::RecordStatus;
+using ArduinoCommon::Config::EepromStorage;
+using ArduinoCommon::Config::InstrumentedStorage;
+using ArduinoCommon::Config::LatencyHistogram;
+using ArduinoCommon::Config::RamStorage;
+using ArduinoCommon::Config::StorageSimulation;
+using ArduinoCommon::Config::WearLeveledStorage;
+#if ARDUINOCOMMON_HAS_MMAP
+using ArduinoCommon::Config::MmapFileStorage;
+#endif
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_wear_leveled_round_trip(void) {
+  FakeConfigStorage backing;
+  WearLeveledStorage<16> config(backing, 0, 256);
+  TEST_ASSERT_TRUE(config.begin());
+  TEST_ASSERT_FALSE(config.isUsed(0, 16));
+
+  const uint16_t a = 1234;
+  const uint32_t b = 0xDEADBEEF;
+  TEST_ASSERT_TRUE(config.write(0, &a, sizeof(a)));
+  TEST_ASSERT_TRUE(config.write(4, &b, sizeof(b)));
+  TEST_ASSERT_FALSE(config.write(14, &b, sizeof(b)));  // out of range
+
+  // Unchanged writes never reach the backing storage.
+  const uint32_t writes = backing.writes;
+  TEST_ASSERT_TRUE(config.write(0, &a, sizeof(a)));
+  TEST_ASSERT_EQUAL(writes, backing.writes);
+
+  WearLeveledStorage<16> reboot(backing, 0, 256);
+  TEST_ASSERT_TRUE(reboot.begin());
+  uint16_t a2 = 0;
+  uint32_t b2 = 0;
+  TEST_ASSERT_TRUE(reboot.read(0, &a2, sizeof(a2)));
+  TEST_ASSERT_TRUE(reboot.read(4, &b2, sizeof(b2)));
+  TEST_ASSERT_EQUAL(a, a2);
+  TEST_ASSERT_EQUAL_HEX32(b, b2);
+  TEST_ASSERT_EQUAL(config.sequence(), reboot.sequence());
+
+  TEST_ASSERT_TRUE(reboot.clear(4, 4));
+  TEST_ASSERT_FALSE(reboot.isUsed(4, 4));
+  TEST_ASSERT_TRUE(reboot.isUsed(0, 2));
+
+  WearLeveledStorage<16> tooSmall(backing, 0, 64);
+  TEST_ASSERT_FALSE(tooSmall.begin());
+}
+
+void test_wear_leveled_spreads_writes(void) {
+  FakeConfigStorage backing;
+  WearLeveledStorage<16> config(backing, 0, 256);
+  TEST_ASSERT_TRUE(config.begin());
+
+  for (uint32_t i = 1; i <= 1000; ++i) {
+    TEST_ASSERT_TRUE(config.write(8, &i, sizeof(i)));
+  }
+  TEST_ASSERT_TRUE(config.compactions() > 0);
+
+  // In place, the counter's bytes would each be written up to 1000 times.
+  TEST_ASSERT_TRUE(backing.maxCellWrites(0, 256) < 150);
+  TEST_ASSERT_EQUAL(0, backing.maxCellWrites(256, 256));
+
+  WearLeveledStorage<16> reboot(backing, 0, 256);
+  TEST_ASSERT_TRUE(reboot.begin());
+  uint32_t value = 0;
+  TEST_ASSERT_TRUE(reboot.read(8, &value, sizeof(value)));
+  TEST_ASSERT_EQUAL(1000, value);
+  TEST_ASSERT_EQUAL(config.activeHalf(), reboot.activeHalf());
+  TEST_ASSERT_EQUAL(config.logOffset(), reboot.logOffset());
+}
+
+void test_wear_leveled_survives_torn_writes(void) {
+  FakeConfigStorage backing;
+  WearLeveledStorage<16> config(backing, 0, 256);
+  TEST_ASSERT_TRUE(config.begin());
+
+  uint32_t value = 1;
+  TEST_ASSERT_TRUE(config.write(0, &value, sizeof(value)));
+
+  // Power fails halfway through a patch record.
+  backing.writeBudget = 6;
+  value = 2;
+  TEST_ASSERT_FALSE(config.write(0, &value, sizeof(value)));
+  backing.writeBudget = -1;
+
+  // The failed write is not visible, so retrying it writes again.
+  uint32_t current = 0;
+  TEST_ASSERT_TRUE(config.read(0, &current, sizeof(current)));
+  TEST_ASSERT_EQUAL(1, current);
+  backing.writeBudget = 0;
+  TEST_ASSERT_FALSE(config.write(0, &value, sizeof(value)));
+  backing.writeBudget = -1;
+
+  WearLeveledStorage<16> reboot(backing, 0, 256);
+  TEST_ASSERT_TRUE(reboot.begin());
+  TEST_ASSERT_TRUE(reboot.read(0, &value, sizeof(value)));
+  TEST_ASSERT_EQUAL(1, value);
+
+  // Fill the active half, then fail during compaction.
+  const uint8_t half = reboot.activeHalf();
+  while (reboot.activeHalf() == half) {
+    const uint32_t before = reboot.compactions();
+    ++value;
+    if (reboot.logOffset() + WearLeveledStorage<16>::HeaderSize + 1 > 128) {
+      backing.writeBudget = 10;
+      TEST_ASSERT_FALSE(reboot.write(0, &value, sizeof(value)));
+      backing.writeBudget = -1;
+      TEST_ASSERT_EQUAL(before, reboot.compactions());
+      break;
+    }
+    TEST_ASSERT_TRUE(reboot.write(0, &value, sizeof(value)));
+  }
+
+  WearLeveledStorage<16> again(backing, 0, 256);
+  TEST_ASSERT_TRUE(again.begin());
+  uint32_t recovered = 0;
+  TEST_ASSERT_TRUE(again.read(0, &recovered, sizeof(recovered)));
+  TEST_ASSERT_EQUAL(value - 1, recovered);
+  TEST_ASSERT_EQUAL(half, again.activeHalf());
+}
+
+void test_wear_leveled_rejects_corrupt_patch(void) {
+  FakeConfigStorage backing;
+  WearLeveledStorage<16> config(backing, 0, 256);
+  TEST_ASSERT_TRUE(config.begin());
+
+  uint32_t value = 1;
+  TEST_ASSERT_TRUE(config.write(0, &value, sizeof(value)));  // snapshot
+  value = 0x01020304;
+  TEST_ASSERT_TRUE(config.write(0, &value, sizeof(value)));  // patch
+
+  // Two adjacent bit flips that cancel out in a rotate-and-xor checksum.
+  const uint16_t payload = WearLeveledStorage<16>::SnapshotSize +
+                           WearLeveledStorage<16>::HeaderSize;
+  backing.bytes[payload] ^= 0x01;
+  backing.bytes[payload + 1] ^= 0x02;
+
+  WearLeveledStorage<16> reboot(backing, 0, 256);
+  TEST_ASSERT_TRUE(reboot.begin());
+  TEST_ASSERT_TRUE(reboot.read(0, &value, sizeof(value)));
+  TEST_ASSERT_EQUAL(1, value);
+}
+
+void test_cached_storage_coalesces_writes(void) {
+  FakeConfigStorage backing;
+  const uint32_t stale = 7;
+  backing.write(16 + 4, &stale, sizeof(stale));
+  backing.writes = 0;
+
+  CachedStorage<64> cache(backing, 16, 0, 0);
+  TEST_ASSERT_TRUE(cache.begin());
+  uint32_t value = 0;
+  TEST_ASSERT_TRUE(cache.read(4, &value, sizeof(value)));
+  TEST_ASSERT_EQUAL(7, value);
+
+  // Ten sensors saving their calibration: no backing writes yet.
+  for (uint16_t i = 0; i < 10; ++i) {
+    const uint32_t calibration = 500 + i;
+    TEST_ASSERT_TRUE(cache.write(i * 4, &calibration, sizeof(calibration)));
+  }
+  TEST_ASSERT_EQUAL(0, backing.writes);
+  TEST_ASSERT_TRUE(cache.dirty());
+  TEST_ASSERT_EQUAL(0, cache.dirtyBegin());
+  TEST_ASSERT_EQUAL(40, cache.dirtyEnd());
+
+  // ...and a single one on flush.
+  TEST_ASSERT_TRUE(cache.flush());
+  TEST_ASSERT_EQUAL(1, backing.writes);
+  TEST_ASSERT_FALSE(cache.dirty());
+  TEST_ASSERT_TRUE(backing.read(16 + 36, &value, sizeof(value)));
+  TEST_ASSERT_EQUAL(509, value);
+
+  // Unchanged data stays clean.
+  value = 509;
+  TEST_ASSERT_TRUE(cache.write(36, &value, sizeof(value)));
+  TEST_ASSERT_FALSE(cache.dirty());
+  TEST_ASSERT_TRUE(cache.flush());
+  TEST_ASSERT_EQUAL(1, backing.writes);
+
+  TEST_ASSERT_TRUE(cache.clear(0, 8));
+  TEST_ASSERT_FALSE(cache.isUsed(0, 8));
+  TEST_ASSERT_TRUE(backing.isUsed(16, 8));
+  TEST_ASSERT_TRUE(cache.flush());
+  TEST_ASSERT_FALSE(backing.isUsed(16, 8));
+  TEST_ASSERT_FALSE(cache.write(62, &value, sizeof(value)));
+}
+
+void test_cached_storage_flush_policy(void) {
+  FakeConfigStorage backing;
+  CachedStorage<32> cache(backing, 0, 100, 300);
+  TEST_ASSERT_TRUE(cache.begin());
+
+  // Idle timeout.
+  uint8_t value = 1;
+  cache.write(0, &value, 1);
+  delay(50);
+  cache.update();
+  TEST_ASSERT_EQUAL(0, backing.writes);
+  delay(60);
+  cache.update();
+  TEST_ASSERT_EQUAL(1, backing.writes);
+
+  // Steady writes never go idle, but the maximum delay still applies.
+  for (uint8_t i = 0; i < 8; ++i) {
+    ++value;
+    cache.write(0, &value, 1);
+    delay(50);
+    cache.update();
+  }
+  TEST_ASSERT_EQUAL(2, backing.writes);
+  TEST_ASSERT_EQUAL(2, cache.flushCount());
+
+  // Pending changes are written back on destruction.
+  {
+    CachedStorage<32> scoped(backing, 0, 0, 0);
+    TEST_ASSERT_TRUE(scoped.begin());
+    value = 42;
+    scoped.write(1, &value, 1);
+  }
+  TEST_ASSERT_EQUAL(42, backing.bytes[1]);
+}
+
+void test_eeprom_storage_block_access(void) {
+  EepromStorage storage(64);
+  TEST_ASSERT_TRUE(storage.clear(0, 64));
+  TEST_ASSERT_FALSE(storage.isUsed(0, 64));
+
+  uint8_t pattern[37];
+  for (uint8_t i = 0; i < sizeof(pattern); ++i) pattern[i] = i * 7;
+  TEST_ASSERT_TRUE(storage.write(3, pattern, sizeof(pattern)));
+
+  uint8_t back[sizeof(pattern)] = {};
+  TEST_ASSERT_TRUE(storage.read(3, back, sizeof(back)));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(pattern, back, sizeof(pattern));
+
+  // Word-wide scan still finds a single used byte at either end.
+  TEST_ASSERT_TRUE(storage.isUsed(0, 5));
+  TEST_ASSERT_TRUE(storage.isUsed(39, 2));
+  TEST_ASSERT_FALSE(storage.isUsed(40, 24));
+  TEST_ASSERT_FALSE(storage.isUsed(0, 3));
+
+  // isUsed() and clear() are range-checked like read() and write().
+  TEST_ASSERT_FALSE(storage.isUsed(60, 8));
+  TEST_ASSERT_FALSE(storage.clear(60, 8));
+  TEST_ASSERT_FALSE(storage.read(60, back, 8));
+  TEST_ASSERT_FALSE(storage.write(60, back, 8));
+
+  TEST_ASSERT_TRUE(storage.clear(0, 64));
+  TEST_ASSERT_FALSE(storage.isUsed(0, 64));
+}
+
+struct Settings {
+  int16_t dry;
+  int16_t wet;
+  uint32_t intervalMs;
+};
+
+void countRecord(const ConfigRecord::Info& /*info*/, void* context) {
+  ++*static_cast<uint8_t*>(context);
+}
+
+void test_crc16_check_value(void) {
+  const char text[] = "123456789";
+  TEST_ASSERT_EQUAL_HEX16(0x29B1, Crc16::compute(text, 9));
+  // Feeding the data in pieces gives the same result.
+  const uint16_t part = Crc16::update(Crc16::Init, text, 4);
+  TEST_ASSERT_EQUAL_HEX16(0x29B1, Crc16::update(part, text + 4, 5));
+}
+
+void test_config_record_framing(void) {
+  FakeConfigStorage storage;
+  const Settings settings = {500, 200, 60000};
+
+  Settings loaded = {};
+  TEST_ASSERT_EQUAL(RecordStatus::Empty,
+                    ConfigRecord::readValue(storage, 0, 1, loaded));
+
+  TEST_ASSERT_TRUE(ConfigRecord::writeValue(storage, 0, 1, 3, settings));
+  uint8_t version = 0;
+  TEST_ASSERT_EQUAL(RecordStatus::Ok,
+                    ConfigRecord::readValue(storage, 0, 1, loaded, &version));
+  TEST_ASSERT_EQUAL(3, version);
+  TEST_ASSERT_EQUAL(500, loaded.dry);
+  TEST_ASSERT_EQUAL(60000, loaded.intervalMs);
+  TEST_ASSERT_EQUAL(RecordStatus::WrongType,
+                    ConfigRecord::readValue(storage, 0, 2, loaded));
+
+  // A second record behind the first; scan() sees both in one pass.
+  const uint16_t second = ConfigRecord::storedSize(sizeof(Settings));
+  const uint8_t blob[40] = {1, 2, 3};
+  TEST_ASSERT_TRUE(ConfigRecord::write(storage, second, 7, 1, blob, 40));
+  uint8_t count = 0;
+  uint16_t stop = 0;
+  TEST_ASSERT_EQUAL(RecordStatus::Ok,
+                    ConfigRecord::scan(storage, 0, 256, countRecord, &count,
+                                       &stop));
+  TEST_ASSERT_EQUAL(2, count);
+  TEST_ASSERT_EQUAL(second + ConfigRecord::storedSize(40), stop);
+
+  // A torn rewrite of the first record is detected, not returned.
+  Settings changed = settings;
+  changed.dry = 480;
+  storage.writeBudget = ConfigRecord::HeaderSize;
+  TEST_ASSERT_FALSE(ConfigRecord::writeValue(storage, 0, 1, 3, changed));
+  storage.writeBudget = -1;
+  TEST_ASSERT_EQUAL(RecordStatus::Corrupt,
+                    ConfigRecord::readValue(storage, 0, 1, loaded));
+  count = 0;
+  TEST_ASSERT_EQUAL(RecordStatus::Corrupt,
+                    ConfigRecord::scan(storage, 0, 256, countRecord, &count,
+                                       &stop));
+  TEST_ASSERT_EQUAL(0, count);
+  TEST_ASSERT_EQUAL(0, stop);
+
+  TEST_ASSERT_TRUE(ConfigRecord::erase(storage, second));
+  TEST_ASSERT_EQUAL(RecordStatus::Empty, ConfigRecord::validate(storage, second));
+}
+
+void test_config_store_keys_and_reboot(void) {
+  FakeConfigStorage storage;
+  ConfigStore<8> store(storage, 64, 256);
+  TEST_ASSERT_TRUE(store.begin());
+  TEST_ASSERT_EQUAL(0, store.count());
+
+  static_assert(ConfigKey("pump.interval").hash != ConfigKey("pump.0").hash,
+                "distinct test keys");
+
+  const Settings soil = {500, 200, 30000};
+  const uint32_t interval = 60000;
+  const char name[] = "greenhouse";
+  TEST_ASSERT_TRUE(store.set("soil.0", soil));
+  TEST_ASSERT_TRUE(store.set("pump.interval", interval));
+  TEST_ASSERT_TRUE(store.set(0x0102, name, sizeof(name)));
+  TEST_ASSERT_EQUAL(3, store.count());
+
+  // Rewriting the same value does not touch the storage.
+  const uint32_t writes = storage.writes;
+  TEST_ASSERT_TRUE(store.set("pump.interval", interval));
+  TEST_ASSERT_EQUAL(writes, storage.writes);
+
+  // Replace with a longer value; the old record is retired.
+  const uint32_t longer[2] = {1, 2};
+  TEST_ASSERT_TRUE(store.set("pump.interval", longer));
+  TEST_ASSERT_EQUAL(8, store.length("pump.interval"));
+  TEST_ASSERT_TRUE(store.remove(0x0102));
+  TEST_ASSERT_FALSE(store.contains(0x0102));
+  TEST_ASSERT_FALSE(store.remove(0x0102));
+
+  ConfigStore<8> reboot(storage, 64, 256);
+  TEST_ASSERT_TRUE(reboot.begin());
+  TEST_ASSERT_EQUAL(2, reboot.count());
+  TEST_ASSERT_EQUAL(store.liveBytes(), reboot.liveBytes());
+  TEST_ASSERT_EQUAL(store.usedBytes(), reboot.usedBytes());
+
+  Settings loaded = {};
+  TEST_ASSERT_TRUE(reboot.get("soil.0", loaded));
+  TEST_ASSERT_EQUAL(200, loaded.wet);
+  uint32_t pair[2] = {};
+  TEST_ASSERT_TRUE(reboot.get("pump.interval", pair));
+  TEST_ASSERT_EQUAL(2, pair[1]);
+  uint32_t tooSmall = 7;
+  TEST_ASSERT_FALSE(reboot.get("pump.interval", tooSmall));
+  TEST_ASSERT_EQUAL(7, tooSmall);
+  char text[16];
+  TEST_ASSERT_EQUAL(-1, reboot.get(0x0102, text, sizeof(text)));
+
+  // Nothing outside the region was touched.
+  TEST_ASSERT_FALSE(storage.isUsed(0, 64));
+  TEST_ASSERT_FALSE(storage.isUsed(320, 192));
+}
+
+void test_config_store_compacts_when_full(void) {
+  FakeConfigStorage storage;
+  ConfigStore<4> store(storage, 0, 128);
+  TEST_ASSERT_TRUE(store.begin());
+
+  // Each record is 14 bytes; 50 updates need far more than 128 bytes.
+  for (uint32_t i = 0; i < 50; ++i) {
+    TEST_ASSERT_TRUE(store.set("counter", i));
+    TEST_ASSERT_TRUE(store.set("other", i * 2));
+  }
+  TEST_ASSERT_TRUE(store.usedBytes() <= 128);
+  TEST_ASSERT_EQUAL(2, store.count());
+
+  ConfigStore<4> reboot(storage, 0, 128);
+  TEST_ASSERT_TRUE(reboot.begin());
+  uint32_t counter = 0;
+  uint32_t other = 0;
+  TEST_ASSERT_TRUE(reboot.get("counter", counter));
+  TEST_ASSERT_TRUE(reboot.get("other", other));
+  TEST_ASSERT_EQUAL(49, counter);
+  TEST_ASSERT_EQUAL(98, other);
+
+  // Key capacity and region size are enforced.
+  TEST_ASSERT_TRUE(reboot.set(1, counter));
+  TEST_ASSERT_TRUE(reboot.set(2, counter));
+  TEST_ASSERT_FALSE(reboot.set(3, counter));
+  uint8_t big[100] = {};
+  TEST_ASSERT_FALSE(reboot.set(1, big, sizeof(big)));
+  TEST_ASSERT_TRUE(reboot.get(1, counter));
+  TEST_ASSERT_EQUAL(49, counter);
+}
+
+void test_config_store_compaction_leaves_no_stale_records(void) {
+  FakeConfigStorage storage;
+  ConfigStore<4> store(storage, 0, 128);
+  TEST_ASSERT_TRUE(store.begin());
+
+  // Reboot after every set, so some reboots land where the moved
+  // records' old copies are not yet overwritten by later appends.
+  uint32_t counter = 0;
+  uint32_t other = 0;
+  for (uint32_t i = 1; i <= 120; ++i) {
+    if (i % 2) {
+      counter = i;
+      TEST_ASSERT_TRUE(store.set("counter", counter));
+    } else {
+      other = i;
+      TEST_ASSERT_TRUE(store.set("other", other));
+    }
+
+    ConfigStore<4> reboot(storage, 0, 128);
+    TEST_ASSERT_TRUE(reboot.begin());
+    uint32_t value = 0;
+    TEST_ASSERT_TRUE(reboot.get("counter", value));
+    TEST_ASSERT_EQUAL(counter, value);
+    if (other) {
+      TEST_ASSERT_TRUE(reboot.get("other", value));
+      TEST_ASSERT_EQUAL(other, value);
+    }
+  }
+
+  // Removed keys stay removed after the next compaction and a reboot.
+  TEST_ASSERT_TRUE(store.set("a", uint32_t(1)));
+  TEST_ASSERT_TRUE(store.set("b", uint32_t(2)));
+  TEST_ASSERT_TRUE(store.remove("a"));
+  TEST_ASSERT_TRUE(store.remove("b"));
+  TEST_ASSERT_TRUE(store.compact());
+  for (uint32_t i = 0; i < 3; ++i) {
+    TEST_ASSERT_TRUE(store.set("counter", i));
+  }
+
+  ConfigStore<4> reboot(storage, 0, 128);
+  TEST_ASSERT_TRUE(reboot.begin());
+  TEST_ASSERT_FALSE(reboot.contains("a"));
+  TEST_ASSERT_FALSE(reboot.contains("b"));
+  TEST_ASSERT_EQUAL(2, reboot.count());
+  TEST_ASSERT_TRUE(reboot.get("counter", counter));
+  TEST_ASSERT_EQUAL(2, counter);
+}
+
+void test_config_store_format_survives_reboot(void) {
+  FakeConfigStorage storage;
+  ConfigStore<4> store(storage, 0, 128);
+  TEST_ASSERT_TRUE(store.begin());
+  TEST_ASSERT_TRUE(store.set("a", uint32_t(1)));
+  TEST_ASSERT_TRUE(store.set("b", uint32_t(2)));
+
+  TEST_ASSERT_TRUE(store.format());
+  TEST_ASSERT_EQUAL(0, store.count());
+  TEST_ASSERT_FALSE(storage.isUsed(0, 128));
+  TEST_ASSERT_TRUE(store.set("c", uint32_t(3)));
+
+  ConfigStore<4> reboot(storage, 0, 128);
+  TEST_ASSERT_TRUE(reboot.begin());
+  TEST_ASSERT_EQUAL(1, reboot.count());
+  TEST_ASSERT_FALSE(reboot.contains("a"));
+  TEST_ASSERT_FALSE(reboot.contains("b"));
+  uint32_t value = 0;
+  TEST_ASSERT_TRUE(reboot.get("c", value));
+  TEST_ASSERT_EQUAL(3, value);
+}
+
+void test_atomic_storage_commits_and_recovers(void) {
+  FakeConfigStorage backing;
+  AtomicStorage config(backing, 0, 40);
+  TEST_ASSERT_EQUAL(96, AtomicStorage::requiredSize(40));
+  TEST_ASSERT_FALSE(config.begin());
+  TEST_ASSERT_FALSE(config.isUsed(0, 40));
+
+  Settings settings = {500, 200, 60000};
+  TEST_ASSERT_TRUE(config.write(8, &settings, sizeof(settings)));
+  TEST_ASSERT_EQUAL(0, config.activeSlot());
+  settings.dry = 510;
+  TEST_ASSERT_TRUE(config.write(8, &settings, sizeof(settings)));
+  TEST_ASSERT_EQUAL(1, config.activeSlot());
+  TEST_ASSERT_TRUE(config.verify());
+
+  // An unchanged write does not commit.
+  const uint32_t writes = backing.writes;
+  TEST_ASSERT_TRUE(config.write(8, &settings, sizeof(settings)));
+  TEST_ASSERT_EQUAL(writes, backing.writes);
+
+  // The next commit reuses slot 0: only the differing bytes and the
+  // header are rewritten.
+  const uint32_t bytesBefore = backing.bytesWritten;
+  settings.dry = 520;
+  TEST_ASSERT_TRUE(config.write(8, &settings, sizeof(settings)));
+  TEST_ASSERT_EQUAL(0, config.activeSlot());
+  TEST_ASSERT_TRUE(backing.bytesWritten - bytesBefore <=
+                   2 + AtomicStorage::HeaderSize);
+
+  // Power fails while the inactive slot's data is being written...
+  settings.dry = 530;
+  settings.intervalMs = 1;
+  backing.writeBudget = 3;
+  TEST_ASSERT_FALSE(config.write(8, &settings, sizeof(settings)));
+  backing.writeBudget = -1;
+
+  AtomicStorage reboot(backing, 0, 40);
+  TEST_ASSERT_TRUE(reboot.begin());
+  TEST_ASSERT_EQUAL(0, reboot.activeSlot());
+  Settings loaded = {};
+  TEST_ASSERT_TRUE(reboot.read(8, &loaded, sizeof(loaded)));
+  TEST_ASSERT_EQUAL(520, loaded.dry);
+  TEST_ASSERT_EQUAL(60000, loaded.intervalMs);
+
+  // ...or while its header is being written.
+  TEST_ASSERT_TRUE(reboot.clear(8, sizeof(settings)));
+  TEST_ASSERT_FALSE(reboot.isUsed(0, 40));
+  settings.dry = 540;
+  backing.writeBudget = 6 + AtomicStorage::HeaderSize / 2;
+  TEST_ASSERT_FALSE(reboot.write(8, &settings, sizeof(settings)));
+  backing.writeBudget = -1;
+
+  AtomicStorage again(backing, 0, 40);
+  TEST_ASSERT_TRUE(again.begin());
+  TEST_ASSERT_EQUAL(reboot.sequence(), again.sequence());
+  TEST_ASSERT_FALSE(again.isUsed(0, 40));
+  TEST_ASSERT_TRUE(again.verify());
+}
+
+void test_ram_storage_simulates_eeprom(void) {
+  StorageSimulation eeprom;
+  eeprom.writeLatencyUs = 3300;
+  RamStorage<64> storage(eeprom);
+  TEST_ASSERT_FALSE(storage.isUsed(0, 64));
+
+  const uint8_t data[4] = {1, 2, 3, 4};
+  TEST_ASSERT_TRUE(storage.write(10, data, 4));
+  TEST_ASSERT_TRUE(storage.write(10, data, 4));  // all skipped
+  TEST_ASSERT_FALSE(storage.write(62, data, 4));
+
+  TEST_ASSERT_EQUAL_UINT32(4, storage.bytesProgrammed());
+  TEST_ASSERT_EQUAL_UINT32(4, storage.bytesSkipped());
+  TEST_ASSERT_EQUAL_UINT32(0, storage.blockErases());
+  TEST_ASSERT_EQUAL_UINT32(4 * 3300UL, storage.simulatedMicros());
+  TEST_ASSERT_EQUAL_UINT32(1, storage.cellWrites(10));
+  TEST_ASSERT_EQUAL_UINT32(0, storage.cellWrites(14));
+
+  uint8_t back[4] = {0};
+  TEST_ASSERT_TRUE(storage.read(10, back, 4));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(data, back, 4);
+
+  storage.resetStats();
+  TEST_ASSERT_EQUAL_UINT32(0, storage.maxCellWrites());
+  TEST_ASSERT_TRUE(storage.isUsed(10, 1));
+}
+
+void test_ram_storage_simulates_flash_erase(void) {
+  StorageSimulation flash;
+  flash.eraseBlockSize = 16;
+  flash.writeLatencyUs = 10;
+  flash.eraseLatencyUs = 1000;
+  RamStorage<64> storage(flash);
+
+  const uint8_t a[2] = {0xF0, 0x0F};
+  TEST_ASSERT_TRUE(storage.write(20, a, 2));  // 1 -> 0 only: no erase
+  TEST_ASSERT_EQUAL_UINT32(0, storage.blockErases());
+  TEST_ASSERT_EQUAL_UINT32(20, storage.simulatedMicros());
+
+  // Clearing bits is still possible without an erase.
+  const uint8_t b[2] = {0x00, 0x0F};
+  TEST_ASSERT_TRUE(storage.write(20, b, 2));
+  TEST_ASSERT_EQUAL_UINT32(0, storage.blockErases());
+
+  // Setting a bit back erases block 16..31 and reprograms its live cells.
+  const uint8_t c[1] = {0x01};
+  TEST_ASSERT_TRUE(storage.write(20, c, 1));
+  TEST_ASSERT_EQUAL_UINT32(1, storage.blockErases());
+  TEST_ASSERT_EQUAL_UINT32(1, storage.cellWrites(16));  // erased only
+  TEST_ASSERT_EQUAL_UINT32(4, storage.cellWrites(20));
+  TEST_ASSERT_EQUAL_UINT32(3, storage.cellWrites(21));  // kept its value
+  TEST_ASSERT_EQUAL_UINT32(0, storage.cellWrites(32));  // other block
+  TEST_ASSERT_EQUAL_UINT8(0x0F, storage.data()[21]);
+
+  // A write spanning two blocks erases each one that needs it.
+  TEST_ASSERT_TRUE(storage.clear(20, 20));
+  TEST_ASSERT_EQUAL_UINT32(2, storage.blockErases());  // 32..47 is erased
+  TEST_ASSERT_FALSE(storage.isUsed(0, 64));
+}
+
+void test_mmap_file_storage_persists(void) {
+#if ARDUINOCOMMON_HAS_MMAP
+  const char* path = "/tmp/arduinocommon_test_storage.bin";
+  remove(path);
+
+  const uint32_t value = 0x12345678;
+  {
+    MmapFileStorage storage;
+    TEST_ASSERT_TRUE(storage.open(path, 128));
+    TEST_ASSERT_FALSE(storage.isUsed(0, 128));
+    TEST_ASSERT_TRUE(storage.write(100, &value, sizeof(value)));
+    TEST_ASSERT_EQUAL_UINT32(1, storage.cellWrites(100));
+  }
+
+  MmapFileStorage storage;
+  TEST_ASSERT_TRUE(storage.open(path, 128));
+  uint32_t back = 0;
+  TEST_ASSERT_TRUE(storage.read(100, &back, sizeof(back)));
+  TEST_ASSERT_EQUAL_HEX32(value, back);
+  TEST_ASSERT_EQUAL_UINT32(0, storage.cellWrites(100));
+  storage.close();
+  TEST_ASSERT_FALSE(storage.read(100, &back, sizeof(back)));
+  remove(path);
+#else
+  TEST_IGNORE_MESSAGE("mmap is not available on this target");
+#endif
+}
+
+struct LayoutSettings {
+  uint16_t intervalS;
+  uint8_t flags;
+};
+
+struct LayoutComponent {
+  static constexpr uint16_t StorageSize =
+      ConfigRecord::storedSize(sizeof(LayoutSettings));
+  static constexpr uint16_t StorageAlign = 4;
+};
+
+typedef ConfigLayout<64, ConfigBytes<3>, LayoutComponent, LayoutComponent,
+                     LayoutSettings>
+    TestLayout;
+
+static_assert(TestLayout::offset<0>() == 0, "first region at 0");
+static_assert(TestLayout::offset<1>() == 4, "aligned up from 3");
+static_assert(TestLayout::sizeOf<1>() == LayoutComponent::StorageSize,
+              "declared footprint");
+static_assert(TestLayout::offset<2>() ==
+                  (4 + LayoutComponent::StorageSize + 3) / 4 * 4,
+              "second component does not overlap the first");
+static_assert(TestLayout::offset<3>() ==
+                  TestLayout::offset<2>() + LayoutComponent::StorageSize,
+              "plain structs are packed");
+static_assert(TestLayout::sizeOf<3>() == sizeof(LayoutSettings),
+              "plain structs use sizeof");
+static_assert(TestLayout::size() ==
+                  TestLayout::offset<3>() + sizeof(LayoutSettings),
+              "total size");
+
+void test_config_layout_regions_do_not_overlap(void) {
+  RamStorage<TestLayout::capacity()> storage;
+  TEST_ASSERT_EQUAL(4, TestLayout::count());
+  TEST_ASSERT_EQUAL_UINT32(64 - TestLayout::size(), TestLayout::freeBytes());
+
+  LayoutSettings a = {60, 1};
+  LayoutSettings b = {300, 2};
+  TEST_ASSERT_TRUE(ConfigRecord::writeValue(storage, TestLayout::offset<1>(),
+                                           0x1111, 1, a));
+  TEST_ASSERT_TRUE(ConfigRecord::writeValue(storage, TestLayout::offset<2>(),
+                                           0x1111, 1, b));
+  TEST_ASSERT_TRUE(storage.write(TestLayout::offset<3>(), &a, sizeof(a)));
+
+  LayoutSettings back;
+  TEST_ASSERT_EQUAL(RecordStatus::Ok,
+                    ConfigRecord::readValue(storage, TestLayout::offset<1>(),
+                                            0x1111, back));
+  TEST_ASSERT_EQUAL(60, back.intervalS);
+  TEST_ASSERT_EQUAL(RecordStatus::Ok,
+                    ConfigRecord::readValue(storage, TestLayout::offset<2>(),
+                                            0x1111, back));
+  TEST_ASSERT_EQUAL(300, back.intervalS);
+  TEST_ASSERT_FALSE(storage.isUsed(TestLayout::size(),
+                                   TestLayout::freeBytes()));
+}
+
+// Stream that records everything printed to it.
+class CaptureStream : public Stream {
+ public:
+  char text[1024] = {};
+  size_t length = 0;
+
+  size_t write(uint8_t c) override {
+    if (length + 1 < sizeof(text)) text[length++] = static_cast<char>(c);
+    return 1;
+  }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+};
+
+void test_instrumented_storage_counts_traffic(void) {
+  StorageSimulation eeprom;
+  eeprom.writeLatencyUs = 100;
+  eeprom.realDelay = true;  // so micros() sees the write cost
+  RamStorage<64> backing(eeprom);
+  InstrumentedStorage stats(backing);
+  TEST_ASSERT_TRUE(stats.addRegion("soilA", 0, 16));
+  TEST_ASSERT_TRUE(stats.addRegion("soilB", 16, 16));
+
+  const uint8_t data[4] = {1, 2, 3, 4};
+  TEST_ASSERT_TRUE(stats.write(2, data, 4));   // commit, 4 bytes changed
+  TEST_ASSERT_TRUE(stats.write(2, data, 4));   // no-op
+  TEST_ASSERT_TRUE(stats.write(20, data, 2));  // soilB
+  TEST_ASSERT_TRUE(stats.clear(20, 4));        // 2 bytes changed
+  TEST_ASSERT_TRUE(stats.write(40, data, 1));  // outside every region
+  TEST_ASSERT_FALSE(stats.write(62, data, 4));
+
+  uint8_t back[4];
+  TEST_ASSERT_TRUE(stats.read(2, back, 4));
+  TEST_ASSERT_TRUE(stats.isUsed(0, 16));
+
+  const auto& a = stats.region(0);
+  TEST_ASSERT_EQUAL_UINT32(2, a.writes);
+  TEST_ASSERT_EQUAL_UINT32(1, a.commits);
+  TEST_ASSERT_EQUAL_UINT32(1, a.noOps);
+  TEST_ASSERT_EQUAL_UINT32(8, a.bytesWritten);
+  TEST_ASSERT_EQUAL_UINT32(4, a.bytesChanged);
+  TEST_ASSERT_EQUAL_UINT32(2, a.reads);
+
+  const auto& b = stats.region(1);
+  TEST_ASSERT_EQUAL_UINT32(1, b.writes);
+  TEST_ASSERT_EQUAL_UINT32(1, b.clears);
+  TEST_ASSERT_EQUAL_UINT32(2, b.commits);
+  TEST_ASSERT_EQUAL_UINT32(4, b.bytesChanged);
+
+  TEST_ASSERT_EQUAL_UINT32(2, stats.other().writes);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.other().failures);
+
+  // 100 us per changed byte; no-ops and rejected writes cost nothing.
+  const LatencyHistogram& writes = stats.writeLatency();
+  TEST_ASSERT_EQUAL_UINT32(5, writes.calls);
+  TEST_ASSERT_EQUAL_UINT32(400, writes.maxMicros);
+  TEST_ASSERT_EQUAL_UINT32(2, writes.counts[0]);  // < 16 us
+  TEST_ASSERT_EQUAL_UINT32(1, writes.counts[3]);  // 64..127 us
+  TEST_ASSERT_EQUAL_UINT32(1, writes.counts[4]);  // 128..255 us
+  TEST_ASSERT_EQUAL_UINT32(1, writes.counts[5]);  // 256..511 us
+
+  CaptureStream out;
+  stats.dumpStats(out);
+  TEST_ASSERT_NOT_NULL(strstr(out.text, "soilA [0..16)"));
+  TEST_ASSERT_NOT_NULL(strstr(out.text, "commits 1, no-ops 1"));
+  TEST_ASSERT_NOT_NULL(strstr(out.text, "(other)"));
+
+  stats.resetStats();
+  TEST_ASSERT_EQUAL_UINT32(0, stats.region(0).writes);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.writeLatency().calls);
+  TEST_ASSERT_EQUAL_STRING("soilA", stats.region(0).name);
+}
+
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+  RUN_TEST(test_wear_leveled_round_trip);
+  RUN_TEST(test_wear_leveled_spreads_writes);
+  RUN_TEST(test_wear_leveled_survives_torn_writes);
+  RUN_TEST(test_wear_leveled_rejects_corrupt_patch);
+  RUN_TEST(test_cached_storage_coalesces_writes);
+  RUN_TEST(test_cached_storage_flush_policy);
+  RUN_TEST(test_eeprom_storage_block_access);
+  RUN_TEST(test_crc16_check_value);
+  RUN_TEST(test_config_record_framing);
+  RUN_TEST(test_config_store_keys_and_reboot);
+  RUN_TEST(test_config_store_compacts_when_full);
+  RUN_TEST(test_config_store_compaction_leaves_no_stale_records);
+  RUN_TEST(test_config_store_format_survives_reboot);
+  RUN_TEST(test_atomic_storage_commits_and_recovers);
+  RUN_TEST(test_ram_storage_simulates_eeprom);
+  RUN_TEST(test_ram_storage_simulates_flash_erase);
+  RUN_TEST(test_mmap_file_storage_persists);
+  RUN_TEST(test_config_layout_regions_do_not_overlap);
+  RUN_TEST(test_instrumented_storage_counts_traffic);
+  UNITY_END();
+}
+
+void loop() {}
@@ -1,10 +1,34 @@
 #include <Arduino.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
 #include <unity.h>
 
-#include "fakes/FakeLiquidCrystal_I2C.h"
+#include "FakeTwoWire.h"
+
+// Sketches forward declare the display classes; keep that compiling.
+namespace ArduinoCommon {
+namespace Display {
+class LCD1602;
+}  // namespace Display
+}  // namespace ArduinoCommon
+
 #include <ArduinoCommon/Display/LCD1602.h>
+#include <ArduinoCommon/Display/Pcf8574Lcd.h>
+#include <ArduinoCommon/Utils/I2cBusManager.h>
+#include <ArduinoCommon/Utils/PinManager.h>
 
+using ArduinoCommon::Display::CharLcd;
 using ArduinoCommon::Display::LCD1602;
+using ArduinoCommon::Display::LCD2004;
+using ArduinoCommon::Display::LCD4002;
+using ArduinoCommon::Display::Pcf8574Lcd;
+using ArduinoCommon::Utils::I2cBusManager;
+using ArduinoCommon::Utils::PinManager;
+
+void setUp(void) { fakeWire().reset(); }
+
+void tearDown(void) {}
 
 void test_printLine_valid_row() {
   Serial.println("before begin()");
@@ -17,10 +41,304 @@ void test_printLine_valid_row() {
   lcd.printLine(0, "Hello");
   Serial.println("after printLine()");
 
-  auto fake = lcd._getLcdForTests();
-  TEST_ASSERT_NOT_NULL(fake);
-  TEST_ASSERT_EQUAL_UINT8(0, fake->lastRow);
-  TEST_ASSERT_EQUAL_STRING("Hello", fake->lastPrint.c_str());
+  auto driver = lcd._getLcdForTests();
+  TEST_ASSERT_NOT_NULL(driver);
+  FakeTwoWire* fake = &driver->bus();
+  TEST_ASSERT_EQUAL_UINT8(0, fake->cursorRow());
+  TEST_ASSERT_EQUAL_STRING("Hello           ", fake->row(0));
+}
+
+void test_flush_sends_only_changed_cells() {
+  LCD1602 lcd(A4, A5);
+  TEST_ASSERT_TRUE(lcd.begin());
+  FakeTwoWire* fake = &lcd._getLcdForTests()->bus();
+
+  lcd.printLine(0, F("Uptime"));
+  lcd.printLine(1, "00:00:09");
+  TEST_ASSERT_EQUAL_STRING("Uptime          ", fake->row(0));
+  TEST_ASSERT_EQUAL_STRING("00:00:09        ", fake->row(1));
+  TEST_ASSERT_FALSE(lcd.dirty());
+
+  // One digit changes: one cursor move and one character, where the old
+  // printLine() sent two cursor moves and 32 characters.
+  fake->resetCounters();
+  lcd.printLine(1, "00:00:10");
+  TEST_ASSERT_EQUAL_UINT32(1, fake->setCursorCalls);
+  TEST_ASSERT_EQUAL_UINT32(2, fake->charsWritten);
+  TEST_ASSERT_EQUAL_STRING("00:00:10        ", fake->row(1));
+
+  // Unchanged text costs nothing.
+  fake->resetCounters();
+  lcd.printLine(1, "00:00:10");
+  TEST_ASSERT_EQUAL_UINT32(0, fake->setCursorCalls);
+  TEST_ASSERT_EQUAL_UINT32(0, fake->charsWritten);
+
+  // Changes one cell apart are merged into a single run.
+  lcd.printLine(1, "00:01:21");
+  TEST_ASSERT_EQUAL_UINT32(1, fake->setCursorCalls);
+  TEST_ASSERT_EQUAL_UINT32(4, fake->charsWritten);
+  TEST_ASSERT_EQUAL_STRING("00:01:21        ", fake->row(1));
+
+  // Text is cut off at the row width.
+  lcd.printLine(0, "0123456789abcdefXYZ");
+  TEST_ASSERT_EQUAL_STRING("0123456789abcdef", fake->row(0));
+  TEST_ASSERT_EQUAL('f', lcd.charAt(15, 0));
+  TEST_ASSERT_EQUAL('\0', lcd.charAt(16, 0));
+}
+
+void test_batched_updates_and_clear() {
+  LCD1602 lcd(A4, A5);
+  lcd.setAutoFlush(false);
+  lcd.printLine(0, "Before begin");
+  TEST_ASSERT_EQUAL_UINT8(0, lcd.flush());  // not initialized yet
+  TEST_ASSERT_TRUE(lcd.begin());
+  FakeTwoWire* fake = &lcd._getLcdForTests()->bus();
+  TEST_ASSERT_EQUAL_STRING("Before begin    ", fake->row(0));
+
+  fake->resetCounters();
+  lcd.printLine(0, "A");
+  lcd.printLine(1, "B");
+  TEST_ASSERT_TRUE(lcd.dirty());
+  TEST_ASSERT_EQUAL_UINT32(0, fake->charsWritten);
+  TEST_ASSERT_EQUAL_STRING("Before begin    ", fake->row(0));
+
+  TEST_ASSERT_EQUAL_UINT8(13, lcd.flush());
+  TEST_ASSERT_EQUAL_STRING("A               ", fake->row(0));
+  TEST_ASSERT_EQUAL_STRING("B               ", fake->row(1));
+
+  lcd.clear();
+  TEST_ASSERT_EQUAL_UINT8(2, lcd.flush());
+  TEST_ASSERT_EQUAL_STRING("                ", fake->row(0));
+  TEST_ASSERT_EQUAL_UINT32(0, fake->clearCalls);
+}
+
+void test_update_sends_bounded_slices() {
+  LCD1602 lcd(A4, A5);
+  TEST_ASSERT_TRUE(lcd.begin());
+  lcd.setAutoFlush(false);
+  FakeTwoWire* fake = &lcd._getLcdForTests()->bus();
+
+  lcd.printLine(0, "Moisture 42%");
+  lcd.printLine(1, "Pump off");
+  TEST_ASSERT_EQUAL_UINT32(0, fake->charsWritten);
+
+  // 12 + 8 changed cells go out 5 at a time; every slice continues
+  // where the previous one left the cursor.
+  uint8_t calls = 0;
+  uint8_t sent;
+  while ((sent = lcd.update(5)) > 0) {
+    TEST_ASSERT_TRUE(sent <= 5);
+    ++calls;
+  }
+  TEST_ASSERT_EQUAL_UINT8(4, calls);
+  TEST_ASSERT_EQUAL_UINT32(20, fake->charsWritten);
+  TEST_ASSERT_EQUAL_UINT32(2, fake->setCursorCalls);
+  TEST_ASSERT_EQUAL_STRING("Moisture 42%    ", fake->row(0));
+  TEST_ASSERT_EQUAL_STRING("Pump off        ", fake->row(1));
+  TEST_ASSERT_FALSE(lcd.dirty());
+
+  // A change behind the resume point is picked up on the next pass.
+  lcd.printLine(1, "Pump on");
+  TEST_ASSERT_EQUAL_UINT8(2, lcd.update(2));
+  lcd.printLine(0, "Moisture 43%");
+  lcd.printLine(1, "Pump off");
+  while (lcd.update() > 0) {
+  }
+  TEST_ASSERT_EQUAL_STRING("Moisture 43%    ", fake->row(0));
+  TEST_ASSERT_EQUAL_STRING("Pump off        ", fake->row(1));
+  TEST_ASSERT_FALSE(lcd.dirty());
+}
+
+void test_driver_batches_nibbles_per_transmission() {
+  FakeTwoWire& bus = fakeWire();
+  {
+    // Without setBusClock(), the application's clock is kept.
+    bus.setClock(400000UL);
+    LCD1602 keeps(A4, A5);
+    TEST_ASSERT_TRUE(keeps.begin());
+    TEST_ASSERT_EQUAL_UINT32(400000UL, bus.clockHz);
+    bus.reset();
+  }
+
+  LCD1602 lcd(A4, A5);
+  lcd.setBusClock(LCD1602::FastMode);
+  TEST_ASSERT_TRUE(lcd.begin());
+  TEST_ASSERT_TRUE(bus.begun);
+  TEST_ASSERT_EQUAL_UINT32(400000UL, bus.clockHz);
+  TEST_ASSERT_FALSE(bus.eightBit);
+  TEST_ASSERT_TRUE(bus.twoLine);
+  TEST_ASSERT_TRUE(bus.displayOn);
+  TEST_ASSERT_TRUE(bus.backlightOn);
+
+  // 16 characters = 32 nibbles of 2 bytes, plus one byte to raise RS.
+  // LiquidCrystal_I2C needed 3 transmissions per nibble (96 in total).
+  bus.resetCounters();
+  lcd.printLine(1, "0123456789abcdef");
+  TEST_ASSERT_EQUAL_STRING("0123456789abcdef", bus.row(1));
+  TEST_ASSERT_EQUAL_UINT32(16, bus.charsWritten);
+  TEST_ASSERT_EQUAL_UINT32(4 + 1 + 64, bus.bytesSent);
+  TEST_ASSERT_EQUAL_UINT32(3, bus.transmissions);
+  TEST_ASSERT_EQUAL_UINT32(0, bus.overflows);
+
+  // Missing backpack: begin() fails on the address probe.
+  LCD1602 other(A4, A5, 0x3F);
+  TEST_ASSERT_TRUE(other.validConfiguration());
+  TEST_ASSERT_FALSE(other.begin());
+}
+
+void test_driver_standalone_rows() {
+  FakeTwoWire& bus = fakeWire();
+  bus.cols = 20;
+  bus.rows = 4;
+  Pcf8574Lcd driver(0x27, 20, 4);
+  TEST_ASSERT_TRUE(driver.probe());
+  driver.init();
+  for (uint8_t row = 0; row < 4; ++row) {
+    driver.setCursor(0, row);
+    driver.print(row % 2 ? "odd" : "even");
+  }
+  TEST_ASSERT_EQUAL_STRING("even                ", bus.row(0));
+  TEST_ASSERT_EQUAL_STRING("                    ", bus.row(3));
+  TEST_ASSERT_TRUE(driver.commit());
+  TEST_ASSERT_EQUAL_STRING("odd                 ", bus.row(1));
+  TEST_ASSERT_EQUAL_STRING("even                ", bus.row(2));
+  TEST_ASSERT_EQUAL_STRING("odd                 ", bus.row(3));
+  bus.cols = 16;
+  bus.rows = 2;
+}
+
+void test_field_formats_without_buffers() {
+  LCD1602 lcd(A4, A5);
+  TEST_ASSERT_TRUE(lcd.begin());
+  FakeTwoWire* fake = &lcd._getLcdForTests()->bus();
+
+  TEST_ASSERT_TRUE(lcd.field(0, 0, 5).print(F("Temp")));
+  TEST_ASSERT_TRUE(lcd.field(0, 5, 6).printFixed(23.46f, 1));
+  TEST_ASSERT_TRUE((lcd.field<0, 11, 5>().printPercent(42)));
+  TEST_ASSERT_EQUAL_STRING("Temp   23.5  42%", fake->row(0));
+
+  TEST_ASSERT_TRUE(lcd.field(1, 0, 2).zeroPad().printUnsigned(7));
+  TEST_ASSERT_TRUE(lcd.field(1, 2, 1).print(':'));
+  TEST_ASSERT_TRUE(lcd.field(1, 3, 5).zeroPad().printInt(-42));
+  TEST_ASSERT_TRUE(lcd.field(1, 8, 5).left().printScaled(-5, 2));
+  TEST_ASSERT_TRUE(lcd.field(1, 13, 3).right().print("ab"));
+  TEST_ASSERT_EQUAL_STRING("07:-0042-0.05 ab", fake->row(1));
+
+  // Too wide: numbers show '#', text is cut off.
+  TEST_ASSERT_FALSE(lcd.field(1, 0, 3).printInt(1234));
+  TEST_ASSERT_FALSE(lcd.field(1, 3, 3).print("abcdef"));
+  TEST_ASSERT_FALSE(lcd.field(1, 6, 4).printFixed(NAN, 1));
+  TEST_ASSERT_TRUE(lcd.field(1, 10, 6).printPercent(99.95f, 1));
+  TEST_ASSERT_EQUAL_STRING("###abc####100.0%", fake->row(1));
+
+  // Clipped to the display.
+  TEST_ASSERT_EQUAL_UINT8(2, lcd.field(0, 14, 8).size());
+  TEST_ASSERT_EQUAL_UINT8(0, lcd.field(2, 0, 4).size());
+  TEST_ASSERT_FALSE(lcd.field(2, 0, 4).printInt(1));
+
+  // Unchanged values send nothing.
+  fake->resetCounters();
+  lcd.field(0, 5, 6).printFixed(23.5f, 1);
+  TEST_ASSERT_EQUAL_UINT32(0, fake->charsWritten);
+}
+
+void test_field_formats_full_range_of_long() {
+  // long is 64 bits on native builds: up to 20 digits plus a sign.
+  FakeTwoWire& bus = fakeWire();
+  bus.cols = 40;
+  {
+    LCD4002 lcd(A4, A5);
+    TEST_ASSERT_TRUE(lcd.begin());
+    char expected[41];
+
+    TEST_ASSERT_TRUE(lcd.field(0, 0, 40).printInt(LONG_MIN));
+    snprintf(expected, sizeof(expected), "%40ld", LONG_MIN);
+    TEST_ASSERT_EQUAL_STRING(expected, bus.row(0));
+
+    TEST_ASSERT_TRUE(lcd.field(0, 0, 40).printUnsigned(ULONG_MAX));
+    snprintf(expected, sizeof(expected), "%40lu", ULONG_MAX);
+    TEST_ASSERT_EQUAL_STRING(expected, bus.row(0));
+
+    TEST_ASSERT_TRUE(lcd.field(1, 0, 40).printInt(LONG_MAX));
+    snprintf(expected, sizeof(expected), "%40ld", LONG_MAX);
+    TEST_ASSERT_EQUAL_STRING(expected, bus.row(1));
+  }
+  bus.cols = 16;
+}
+
+void test_displays_share_i2c_pins() {
+  {
+    LCD1602 status(A4, A5, 0x27);
+    LCD2004 details(A4, A5, 0x3F);
+    TEST_ASSERT_TRUE(status.validConfiguration());
+    TEST_ASSERT_TRUE(details.validConfiguration());
+    TEST_ASSERT_EQUAL_UINT8(2, I2cBusManager::userCount(A4, A5));
+
+    // The pins are still protected from everything but another display.
+    TEST_ASSERT_FALSE(PinManager::reservePin(A4));
+
+    TEST_ASSERT_TRUE(status.begin());
+    status.printLine(0, F("status"));
+    TEST_ASSERT_EQUAL_STRING("status          ", fakeWire().row(0));
+  }
+  TEST_ASSERT_EQUAL_UINT8(0, I2cBusManager::userCount(A4, A5));
+  TEST_ASSERT_FALSE(PinManager::isPinUsed(A4));
+  TEST_ASSERT_FALSE(PinManager::isPinUsed(A5));
+}
+
+void test_second_pin_pair_needs_own_controller() {
+  LCD1602 first(A4, A5);
+  TEST_ASSERT_TRUE(first.validConfiguration());
+
+  {
+    // Wire cannot drive a second pin pair as well.
+    LCD1602 second(2, 3);
+    TEST_ASSERT_FALSE(second.validConfiguration());
+    TEST_ASSERT_FALSE(second.begin());
+  }
+  TEST_ASSERT_FALSE(PinManager::isPinUsed(2));
+
+  // A display on the same pins through another controller is rejected
+  // too; one on its own pins and controller is fine.
+  FakeTwoWire other;
+  LCD1602 wrongBus(A4, A5, 0x3F, other);
+  TEST_ASSERT_FALSE(wrongBus.validConfiguration());
+
+  other.address = 0x3F;
+  LCD1602 second(2, 3, 0x3F, other);
+  TEST_ASSERT_TRUE(second.validConfiguration());
+  TEST_ASSERT_TRUE(second.begin());
+  second.printLine(0, F("second bus"));
+  TEST_ASSERT_EQUAL_STRING("second bus      ", other.row(0));
+  TEST_ASSERT_EQUAL_UINT32(0, fakeWire().transmissions);
+}
+
+void test_geometry_from_template() {
+  FakeTwoWire& bus = fakeWire();
+  bus.cols = 20;
+  bus.rows = 4;
+  {
+    LCD2004 lcd(A4, A5);
+    TEST_ASSERT_EQUAL_UINT8(0x54, LCD2004::rowOffset(3));
+    TEST_ASSERT_TRUE(lcd.begin());
+
+    lcd.printLine(3, "last row of twenty!!");
+    lcd.printLine(4, "ignored");
+    TEST_ASSERT_TRUE((lcd.field<2, 15, 5>().printInt(12345)));
+    TEST_ASSERT_EQUAL_STRING("last row of twenty!!", bus.row(3));
+    TEST_ASSERT_EQUAL_STRING("               12345", bus.row(2));
+    TEST_ASSERT_EQUAL_STRING("                    ", bus.row(1));
+
+    bus.resetCounters();
+    lcd.printLine(3, "last row of twenty!?");
+    TEST_ASSERT_EQUAL_UINT32(1, bus.setCursorCalls);
+    TEST_ASSERT_EQUAL_UINT32(1, bus.charsWritten);
+  }
+
+  static_assert(CharLcd<40, 2>::rowOffset(1) == 0x40, "40x2 row 1");
+  static_assert(CharLcd<16, 4>::rowOffset(2) == 16, "16x4 row 2");
+  bus.cols = 16;
+  bus.rows = 2;
 }
 
 void setup() {
@@ -37,6 +355,16 @@ void setup() {
 
   UNITY_BEGIN();
   RUN_TEST(test_printLine_valid_row);
+  RUN_TEST(test_flush_sends_only_changed_cells);
+  RUN_TEST(test_batched_updates_and_clear);
+  RUN_TEST(test_update_sends_bounded_slices);
+  RUN_TEST(test_driver_batches_nibbles_per_transmission);
+  RUN_TEST(test_driver_standalone_rows);
+  RUN_TEST(test_field_formats_without_buffers);
+  RUN_TEST(test_field_formats_full_range_of_long);
+  RUN_TEST(test_displays_share_i2c_pins);
+  RUN_TEST(test_second_pin_pair_needs_own_controller);
+  RUN_TEST(test_geometry_from_template);
   UNITY_END();
 
   Serial.println("done");
@@ -1,8 +1,39 @@
 #include <Arduino.h>
 #include <unity.h>
 
-#include <ArduinoCommon/Sensors/SoilSensor.h>
+#include "FakeAdcBackend.h"
+#include "FakeConfigStorage.h"
+#include <ArduinoCommon/Config/IConfigStorage.h>
+#include <ArduinoCommon/Sensors/AdcScanner.h>
+#include <ArduinoCommon/Sensors/AutoCalibrator.h>
+#include <ArduinoCommon/Sensors/CalibrationCurve.h>
+#include <ArduinoCommon/Sensors/FilteredSensor.h>
+#include <ArduinoCommon/Sensors/PercentMap.h>
+#include <ArduinoCommon/Sensors/SensorGroup.h>
+#include <ArduinoCommon/Sensors/SensorHistory.h>
+#include <ArduinoCommon/Sensors/StaticSoilSensor.h>
+#include <ArduinoCommon/Sensors/SOILSENSOR.h>
 
+using ArduinoCommon::Sensors::AdcScanner;
+using ArduinoCommon::Sensors::AutoCalibrationConfig;
+using ArduinoCommon::Sensors::AutoCalibrator;
+using ArduinoCommon::Sensors::CalibrationCurve;
+using ArduinoCommon::Sensors::CalibrationLut;
+using ArduinoCommon::Sensors::CalibrationPoint;
+using ArduinoCommon::Sensors::Ema;
+using ArduinoCommon::Sensors::FilteredSensor;
+using ArduinoCommon::Sensors::IAnalogSensor;
+using ArduinoCommon::Sensors::Kalman;
+using ArduinoCommon::Sensors::Median;
+using ArduinoCommon::Sensors::MovingAverage;
+using ArduinoCommon::Sensors::PercentMap;
+using ArduinoCommon::Sensors::SensorGroup;
+using ArduinoCommon::Sensors::SensorHistory;
+using ArduinoCommon::Sensors::SoilCalibration;
+using ArduinoCommon::Sensors::StaticSoilSensor;
+using ArduinoCommon::Sensors::VirtualAnalogSensor;
+using ArduinoCommon::Sensors::WatchEvent;
+using ArduinoCommon::Sensors::WatchSource;
 using ArduinoCommon::Sensors::SoilSensor;
 
 void setUp(void) {}
@@ -23,10 +54,838 @@ void test_soilsensor_begin_and_calibration(void) {
   TEST_ASSERT_EQUAL(200, cal.wetRaw);
 }
 
+void test_soilsensor_async_sampling(void) {
+  SoilSensor sensor(A1);
+
+  TEST_ASSERT_FALSE(sensor.startSampling(4, 5));  // not configured yet
+  TEST_ASSERT_TRUE(sensor.begin());
+
+  TEST_ASSERT_FALSE(sensor.isReady());
+  TEST_ASSERT_EQUAL(-1, sensor.sampledRaw());
+  TEST_ASSERT_FALSE(sensor.startSampling(0, 5));
+
+  TEST_ASSERT_TRUE(sensor.startSampling(4, 5));
+  TEST_ASSERT_TRUE(sensor.isSampling());
+
+  const unsigned long start = millis();
+  while (!sensor.isReady() && millis() - start < 1000) {
+    sensor.update();
+    delay(1);
+  }
+
+  TEST_ASSERT_TRUE(sensor.isReady());
+  TEST_ASSERT_FALSE(sensor.isSampling());
+  TEST_ASSERT_TRUE(sensor.sampledRaw() >= 0);
+  TEST_ASSERT_TRUE(sensor.sampledPercent() >= 0);
+}
+
+void test_adcscanner_ring_buffer(void) {
+  FakeAdcBackend backend;
+  AdcScanner scanner(backend);
+
+  TEST_ASSERT_FALSE(scanner.begin());  // no channels yet
+  TEST_ASSERT_EQUAL(0, scanner.addChannel(A2));
+  TEST_ASSERT_EQUAL(1, scanner.addChannel(A3));
+  TEST_ASSERT_EQUAL(0, scanner.addChannel(A2));  // already registered
+  TEST_ASSERT_TRUE(scanner.begin());
+  TEST_ASSERT_EQUAL(-1, scanner.addChannel(A4));  // running
+  TEST_ASSERT_EQUAL(2, backend.channelCount);
+
+  TEST_ASSERT_EQUAL(-1, scanner.latest(0));
+
+  for (uint16_t i = 0; i < AdcScanner::BufferDepth + 3; ++i) {
+    backend.setValue(0, 100 + i);
+    backend.setValue(1, 200 + i);
+    scanner.update();
+  }
+
+  TEST_ASSERT_EQUAL(100 + AdcScanner::BufferDepth + 2, scanner.latest(0));
+  TEST_ASSERT_EQUAL(200 + AdcScanner::BufferDepth + 2, scanner.latest(1));
+  TEST_ASSERT_EQUAL(AdcScanner::BufferDepth, scanner.available(0));
+
+  // Overrun: the three oldest samples were overwritten.
+  uint16_t value = 0;
+  TEST_ASSERT_TRUE(scanner.pop(0, value));
+  TEST_ASSERT_EQUAL(103, value);
+
+  scanner.end();
+  TEST_ASSERT_TRUE(backend.endCalled);
+}
+
+void test_adcscanner_overrun_by_many_laps(void) {
+  FakeAdcBackend backend;
+  AdcScanner scanner(backend);
+  TEST_ASSERT_EQUAL(0, scanner.addChannel(A2));
+  TEST_ASSERT_TRUE(scanner.begin());
+
+  // Exactly 256 pushes behind used to look like an empty buffer.
+  for (uint16_t i = 0; i < 256; ++i) {
+    backend.setValue(0, i);
+    scanner.update();
+  }
+  TEST_ASSERT_EQUAL(AdcScanner::BufferDepth, scanner.available(0));
+  uint16_t value = 0;
+  TEST_ASSERT_TRUE(scanner.pop(0, value));
+  TEST_ASSERT_EQUAL(256 - AdcScanner::BufferDepth, value);
+
+  // Any other lag past 256 still keeps the newest BufferDepth samples.
+  for (uint16_t i = 0; i < 300; ++i) {
+    backend.setValue(0, 1000 + i);
+    scanner.update();
+  }
+  TEST_ASSERT_EQUAL(AdcScanner::BufferDepth, scanner.available(0));
+  for (uint16_t i = 0; i < AdcScanner::BufferDepth; ++i) {
+    TEST_ASSERT_TRUE(scanner.pop(0, value));
+    TEST_ASSERT_EQUAL(1300 - AdcScanner::BufferDepth + i, value);
+  }
+  TEST_ASSERT_FALSE(scanner.pop(0, value));
+
+  scanner.end();
+}
+
+void test_soilsensor_reads_from_scanner(void) {
+  FakeAdcBackend backend;
+  AdcScanner scanner(backend);
+  SoilSensor sensor(A5);
+
+  TEST_ASSERT_TRUE(sensor.begin(500, 200));
+  TEST_ASSERT_TRUE(sensor.attachScanner(&scanner));
+  TEST_ASSERT_TRUE(scanner.begin());
+
+  TEST_ASSERT_EQUAL(-1, sensor.readRaw());  // nothing converted yet
+
+  backend.setValue(0, 350);
+  scanner.update();
+  TEST_ASSERT_EQUAL(350, sensor.readRaw());
+  TEST_ASSERT_EQUAL(50, sensor.readPercent());
+
+  TEST_ASSERT_TRUE(sensor.attachScanner(nullptr));
+}
+
+void test_sensorgroup_batch_percent(void) {
+  FakeAdcBackend backend;
+  AdcScanner scanner(backend);
+  SensorGroup<3> group;
+
+  TEST_ASSERT_EQUAL(0, group.add(6, 500, 200));
+  TEST_ASSERT_EQUAL(1, group.add(7, 250, 550));  // inverted calibration
+  TEST_ASSERT_EQUAL(2, group.add(8));            // uncalibrated
+  TEST_ASSERT_EQUAL(-1, group.add(9));           // full
+  TEST_ASSERT_TRUE(group.attachScanner(&scanner));
+  TEST_ASSERT_TRUE(scanner.begin());
+
+  backend.setValue(0, 350);
+  backend.setValue(1, 700);
+  backend.setValue(2, 1023);
+  scanner.update();
+  group.update();
+
+  TEST_ASSERT_EQUAL(350, group.raw(0));
+  TEST_ASSERT_EQUAL(50, group.percent(0));
+  TEST_ASSERT_EQUAL(0, group.percent(1));
+  TEST_ASSERT_EQUAL(100, group.percent(2));
+  TEST_ASSERT_EQUAL(group.percent(0), group.percentData()[0]);
+}
+
+// Reference: the clamped map() based conversion PercentMap replaces.
+static int referencePercent(int raw, int16_t dry, int16_t wet) {
+  int16_t minVal = dry < wet ? dry : wet;
+  int16_t maxVal = dry < wet ? wet : dry;
+  int clamped = raw;
+  if (clamped < minVal) clamped = minVal;
+  if (clamped > maxVal) clamped = maxVal;
+  int percent = map(clamped, minVal, maxVal, 100, 0);
+  if (percent < 0) percent = 0;
+  if (percent > 100) percent = 100;
+  return percent;
+}
+
+void test_percentmap_matches_map_over_adc_range(void) {
+  const int16_t calibrations[][2] = {
+      {500, 200}, {200, 500}, {1023, 0}, {0, 1023}, {601, 600},
+      {3, 1},     {4095, 0},  {3100, 1234}, {16383, 0}, {12000, 4321},
+  };
+
+  for (const auto& cal : calibrations) {
+    const PercentMap pm = PercentMap::fromCalibration(cal[0], cal[1]);
+    TEST_ASSERT_TRUE(pm.valid);
+
+    for (int raw = 0; raw <= 16383; ++raw) {
+      if (pm.toPercent(raw) != referencePercent(raw, cal[0], cal[1])) {
+        TEST_ASSERT_EQUAL_INT(referencePercent(raw, cal[0], cal[1]),
+                              pm.toPercent(raw));
+      }
+    }
+  }
+
+  TEST_ASSERT_FALSE(PercentMap::fromCalibration(300, 300).valid);
+  TEST_ASSERT_FALSE(PercentMap::fromCalibration(-1, 300).valid);
+}
+
+void test_percentmap_every_range(void) {
+  // Every possible 10- and 12-bit span, checked at both ends and midpoints.
+  for (int16_t range = 1; range <= 4095; ++range) {
+    const PercentMap pm = PercentMap::fromCalibration(0, range);
+    for (int raw = 0; raw <= range; raw += (range / 97) + 1) {
+      if (pm.toPercent(raw) != referencePercent(raw, 0, range)) {
+        TEST_ASSERT_EQUAL_INT(referencePercent(raw, 0, range),
+                              pm.toPercent(raw));
+      }
+    }
+    TEST_ASSERT_EQUAL_INT(0, pm.toPercent(range));
+  }
+}
+
+// Minimal sensor that replays a scripted sequence of raw values.
+class ScriptedSensor : public IAnalogSensor {
+ public:
+  const int* values = nullptr;
+  size_t count = 0;
+  mutable size_t next = 0;
+
+  bool validConfiguration() const override { return true; }
+  int readRaw() const override {
+    return next < count ? values[next++] : -1;
+  }
+  int rawToPercent(int raw) const override { return raw / 10; }
+};
+
+void test_filter_stages(void) {
+  MovingAverage<4> avg;
+  TEST_ASSERT_EQUAL(10, avg.apply(10));
+  TEST_ASSERT_EQUAL(15, avg.apply(20));
+  avg.apply(30);
+  TEST_ASSERT_EQUAL(25, avg.apply(40));
+  TEST_ASSERT_EQUAL(35, avg.apply(50));  // 10 dropped
+
+  Median<5> median;
+  const int spikes[] = {100, 102, 900, 101, 99, 0, 103};
+  int out = 0;
+  for (int v : spikes) out = median.apply(v);
+  TEST_ASSERT_EQUAL(101, out);  // window {900,101,99,0,103}
+
+  Ema<128> ema;  // alpha = 0.5
+  TEST_ASSERT_EQUAL(100, ema.apply(100));
+  TEST_ASSERT_EQUAL(150, ema.apply(200));
+  TEST_ASSERT_EQUAL(175, ema.apply(200));
+  ema.reset();
+  TEST_ASSERT_EQUAL(40, ema.apply(40));
+
+  Kalman<1, 400> kalman;
+  kalman.apply(500);
+  for (int i = 0; i < 50; ++i) out = kalman.apply(i % 2 ? 510 : 490);
+  TEST_ASSERT_INT_WITHIN(3, 500, out);
+}
+
+void test_filtered_sensor_pipeline(void) {
+  const int values[] = {300, 310, 1000, 305, 300};
+  ScriptedSensor raw;
+  raw.values = values;
+  raw.count = 5;
+
+  FilteredSensor<ScriptedSensor, Median<3>, MovingAverage<2>> filtered(raw);
+  TEST_ASSERT_FALSE(filtered.isReady());
+  TEST_ASSERT_EQUAL(-1, filtered.readRaw());
+
+  for (size_t i = 0; i < 5; ++i) filtered.update();
+  // Medians: 300, 310, 310, 310, 305 -> average of the last two.
+  TEST_ASSERT_EQUAL(307, filtered.readRaw());
+  TEST_ASSERT_EQUAL(30, filtered.readPercent());
+
+  filtered.update();  // source exhausted: value is kept
+  TEST_ASSERT_EQUAL(307, filtered.readRaw());
+
+  filtered.reset();
+  TEST_ASSERT_EQUAL(-1, filtered.readRaw());
+}
+
+void test_soilsensor_oversampling(void) {
+  SoilSensor sensor(A3);
+  TEST_ASSERT_TRUE(sensor.begin(500, 200));
+
+  const uint8_t adcBits = ArduinoCommon::Sensors::AdcResolution::bits();
+  TEST_ASSERT_EQUAL(adcBits, sensor.resolutionBits());
+
+  TEST_ASSERT_TRUE(sensor.setOversampling(2));
+  TEST_ASSERT_EQUAL(adcBits + 2, sensor.resolutionBits());
+  TEST_ASSERT_EQUAL(2000, sensor.getCalibration().dryRaw);
+  TEST_ASSERT_EQUAL(800, sensor.getCalibration().wetRaw);
+
+  const int raw = sensor.readRaw();
+  TEST_ASSERT_TRUE(raw >= 0);
+  TEST_ASSERT_TRUE(raw < (1L << sensor.resolutionBits()));
+
+  TEST_ASSERT_FALSE(sensor.setOversampling(16 - adcBits));  // too wide
+  TEST_ASSERT_EQUAL(2, sensor.oversamplingBits());
+
+  // update() takes one conversion per call: 16 calls per sample.
+  TEST_ASSERT_TRUE(sensor.startSampling(2, 0));
+  for (uint8_t i = 0; i < 31; ++i) sensor.update();
+  TEST_ASSERT_TRUE(sensor.isSampling());
+  sensor.update();
+  TEST_ASSERT_TRUE(sensor.isReady());
+  TEST_ASSERT_TRUE(sensor.sampledRaw() < (1L << sensor.resolutionBits()));
+
+  TEST_ASSERT_TRUE(sensor.setOversampling(0));
+  TEST_ASSERT_EQUAL(500, sensor.getCalibration().dryRaw);
+  TEST_ASSERT_EQUAL(200, sensor.getCalibration().wetRaw);
+}
+
+// Stream that records everything printed to it.
+class CaptureStream : public Stream {
+ public:
+  char text[64] = {};
+  size_t length = 0;
+
+  size_t write(uint8_t c) override {
+    if (length + 1 < sizeof(text)) text[length++] = static_cast<char>(c);
+    return 1;
+  }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+};
+
+void test_static_soilsensor_matches_virtual(void) {
+  static_assert(!__is_polymorphic(StaticSoilSensor),
+                "StaticSoilSensor must not have a vtable");
+
+  StaticSoilSensor fast(A4);
+  SoilSensor reference(A2);
+  TEST_ASSERT_TRUE(fast.begin(500, 200));
+  TEST_ASSERT_TRUE(reference.begin(500, 200));
+  TEST_ASSERT_TRUE(fast.validConfiguration());
+
+  for (int raw = 0; raw <= 1023; ++raw) {
+    if (fast.rawToPercent(raw) != reference.rawToPercent(raw)) {
+      TEST_ASSERT_EQUAL_INT(reference.rawToPercent(raw),
+                            fast.rawToPercent(raw));
+    }
+  }
+
+  VirtualAnalogSensor<StaticSoilSensor> adapter(fast);
+  IAnalogSensor* sensors[] = {&adapter, &reference};
+  TEST_ASSERT_TRUE(sensors[0]->validConfiguration());
+  TEST_ASSERT_EQUAL(fast.rawToPercent(350), sensors[0]->rawToPercent(350));
+
+  CaptureStream out;
+  fast.logRaw(out, "Fast");
+  TEST_ASSERT_EQUAL_INT(0, strncmp(out.text, "Fast: ", 6));
+
+  fast.end();
+  TEST_ASSERT_FALSE(fast.validConfiguration());
+  TEST_ASSERT_EQUAL(-1, fast.readRaw());
+}
+
+void test_sensor_history_window_stats(void) {
+  SensorHistory<4> history;
+  TEST_ASSERT_EQUAL(0, history.count());
+  TEST_ASSERT_EQUAL(-1, history.minimum());
+
+  const int16_t values[] = {10, 40, 20, 30, 50};
+  for (uint8_t i = 0; i < 5; ++i) history.push(values[i], i * 100UL);
+
+  // 10 was evicted by capacity: window is {40, 20, 30, 50}.
+  TEST_ASSERT_EQUAL(4, history.count());
+  TEST_ASSERT_EQUAL(20, history.minimum());
+  TEST_ASSERT_EQUAL(50, history.maximum());
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 35.0f, history.mean());
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 166.67f, history.variance());
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.91f, history.stddev());
+  TEST_ASSERT_EQUAL(40, history.oldest().value);
+  TEST_ASSERT_EQUAL(400UL, history.newest().timeMs);
+
+  SensorHistory<8> timed(250);
+  timed.push(100, 0);
+  timed.push(5, 100);
+  timed.push(60, 200);
+  TEST_ASSERT_EQUAL(5, timed.minimum());
+  timed.push(70, 360);  // samples at t=0 and t=100 expire
+  TEST_ASSERT_EQUAL(2, timed.count());
+  TEST_ASSERT_EQUAL(60, timed.minimum());
+  TEST_ASSERT_EQUAL(70, timed.maximum());
+  timed.expire(1000);
+  TEST_ASSERT_EQUAL(0, timed.count());
+}
+
+struct WatchLog {
+  uint8_t calls = 0;
+  WatchEvent lastType = WatchEvent::Changed;
+  int lastValue = -1;
+};
+
+static void recordWatch(IAnalogSensor&,
+                        const ArduinoCommon::Sensors::SensorEvent& event,
+                        void* context) {
+  WatchLog* log = static_cast<WatchLog*>(context);
+  ++log->calls;
+  log->lastType = event.type;
+  log->lastValue = event.value;
+}
+
+// Feed one completed single-sample run with the given raw value.
+static void feedRun(SoilSensor& sensor, AdcScanner& scanner,
+                    FakeAdcBackend& backend, uint16_t raw) {
+  backend.setValue(0, raw);
+  scanner.update();
+  sensor.startSampling(1, 0);
+  sensor.update();
+}
+
+void test_soilsensor_watches(void) {
+  FakeAdcBackend backend;
+  AdcScanner scanner(backend);
+  SoilSensor sensor(12);
+  TEST_ASSERT_TRUE(sensor.begin(500, 200));  // 350 raw = 50 %
+  TEST_ASSERT_TRUE(sensor.attachScanner(&scanner));
+  TEST_ASSERT_TRUE(scanner.begin());
+
+  WatchLog threshold;
+  WatchLog deadband;
+  const int8_t thresholdId = sensor.addThresholdWatch(
+      WatchSource::Percent, 30, 5, recordWatch, &threshold);
+  TEST_ASSERT_TRUE(thresholdId >= 0);
+  TEST_ASSERT_TRUE(sensor.addDeadbandWatch(WatchSource::Raw, 20, recordWatch,
+                                           &deadband) >= 0);
+
+  feedRun(sensor, scanner, backend, 350);  // 50 %: initial state
+  TEST_ASSERT_EQUAL(1, threshold.calls);
+  TEST_ASSERT_TRUE(threshold.lastType == WatchEvent::Above);
+  TEST_ASSERT_EQUAL(1, deadband.calls);
+
+  feedRun(sensor, scanner, backend, 360);  // within deadband, above limit
+  TEST_ASSERT_EQUAL(1, threshold.calls);
+  TEST_ASSERT_EQUAL(1, deadband.calls);
+
+  feedRun(sensor, scanner, backend, 425);  // 25 %: crossed below
+  TEST_ASSERT_EQUAL(2, threshold.calls);
+  TEST_ASSERT_TRUE(threshold.lastType == WatchEvent::Below);
+  TEST_ASSERT_EQUAL(25, threshold.lastValue);
+  TEST_ASSERT_EQUAL(2, deadband.calls);
+  TEST_ASSERT_EQUAL(425, deadband.lastValue);
+
+  feedRun(sensor, scanner, backend, 398);  // 34 %: inside hysteresis
+  TEST_ASSERT_EQUAL(2, threshold.calls);
+
+  feedRun(sensor, scanner, backend, 392);  // 36 %: recovered
+  TEST_ASSERT_EQUAL(3, threshold.calls);
+  TEST_ASSERT_TRUE(threshold.lastType == WatchEvent::Above);
+
+  TEST_ASSERT_TRUE(sensor.removeWatch(thresholdId));
+  TEST_ASSERT_FALSE(sensor.removeWatch(thresholdId));
+  feedRun(sensor, scanner, backend, 500);
+  TEST_ASSERT_EQUAL(3, threshold.calls);
+}
+
+void test_autocalibrator_rejects_spikes(void) {
+  AutoCalibrationConfig config;
+  config.minSamples = 4;
+  config.minSpan = 50;
+  config.maxValidRaw = 1022;
+  AutoCalibrator cal(config);
+
+  for (int i = 0; i < 4; ++i) cal.observe(300);
+  TEST_ASSERT_FALSE(cal.hasCalibration());  // no span yet
+
+  cal.observe(1023);  // rail value: ignored
+  cal.observe(900);   // single spike: not confirmed
+  cal.observe(300);
+  TEST_ASSERT_FALSE(cal.hasCalibration());
+
+  bool changed = false;
+  for (int i = 0; i < 3; ++i) changed = cal.observe(520 + i * 10);
+  TEST_ASSERT_TRUE(changed);
+  TEST_ASSERT_TRUE(cal.hasCalibration());
+  TEST_ASSERT_EQUAL(520, cal.calibration().dryRaw);  // least extreme of run
+  TEST_ASSERT_EQUAL(300, cal.calibration().wetRaw);
+}
+
+void test_soilsensor_autocalibration_throttles_writes(void) {
+  FakeAdcBackend backend;
+  AdcScanner scanner(backend);
+  FakeConfigStorage storage;
+  SoilSensor sensor(13);
+  sensor.attachStorage(&storage, 0);
+  TEST_ASSERT_TRUE(sensor.begin(500, 200));
+  TEST_ASSERT_EQUAL(1, storage.writes);
+  TEST_ASSERT_TRUE(sensor.attachScanner(&scanner));
+  TEST_ASSERT_TRUE(scanner.begin());
+
+  sensor.setCalibration(500, 200, true);  // unchanged: no rewrite
+  TEST_ASSERT_EQUAL(1, storage.writes);
+
+  AutoCalibrationConfig config;
+  config.confirmSamples = 1;
+  config.persistThreshold = 20;
+  config.persistIntervalMs = 500;
+  sensor.enableAutoCalibration(config);
+  TEST_ASSERT_TRUE(sensor.autoCalibrationEnabled());
+
+  feedRun(sensor, scanner, backend, 510);  // small drift: apply only
+  TEST_ASSERT_EQUAL(510, sensor.getCalibration().dryRaw);
+  TEST_ASSERT_EQUAL(1, storage.writes);
+
+  feedRun(sensor, scanner, backend, 560);  // big drift, interval not over
+  TEST_ASSERT_EQUAL(560, sensor.getCalibration().dryRaw);
+  TEST_ASSERT_EQUAL(1, storage.writes);
+
+  delay(501);
+  feedRun(sensor, scanner, backend, 570);
+  TEST_ASSERT_EQUAL(2, storage.writes);
+
+  sensor.disableAutoCalibration();
+  feedRun(sensor, scanner, backend, 700);
+  TEST_ASSERT_EQUAL(570, sensor.getCalibration().dryRaw);
+}
+
+void test_autocalibrator_keeps_calibration_through_steady_readings(void) {
+  // Default config, seeded with a good calibration, then weeks of
+  // readings around 400 every 2 s: the soil never visits its extremes.
+  AutoCalibrator cal;
+  ArduinoCommon::Sensors::SoilCalibration seeded;
+  seeded.dryRaw = 520;
+  seeded.wetRaw = 210;
+  cal.seed(seeded);
+
+  const uint32_t stepMs = 2000;
+  const uint32_t day = 24UL * 60UL * 60UL * 1000UL;
+  uint32_t now = 0;
+  uint32_t i = 0;
+  for (; now < day / 4; now += stepMs, ++i) cal.observe(399 + i % 3, now);
+  TEST_ASSERT_EQUAL(520, cal.calibration().dryRaw);  // no decay yet
+  TEST_ASSERT_EQUAL(210, cal.calibration().wetRaw);
+
+  for (; now < 7 * day; now += stepMs, ++i) cal.observe(399 + i % 3, now);
+  TEST_ASSERT_TRUE(cal.hasCalibration());
+  TEST_ASSERT_TRUE(cal.calibration().dryRaw >= 500);
+  TEST_ASSERT_TRUE(cal.calibration().wetRaw <= 240);
+
+  for (; now < 30 * day; now += stepMs, ++i) cal.observe(399 + i % 3, now);
+  TEST_ASSERT_TRUE(cal.hasCalibration());
+  TEST_ASSERT_TRUE(cal.calibration().dryRaw >= 470);
+  TEST_ASSERT_TRUE(cal.calibration().wetRaw <= 290);
+
+  // With fast decay, the range still stops at minSpan.
+  AutoCalibrationConfig fast;
+  fast.decayIntervalMs = 0;
+  fast.decayShift = 1;
+  cal.configure(fast);
+  for (int n = 0; n < 100; ++n) cal.observe(400, now);
+  TEST_ASSERT_TRUE(cal.hasCalibration());
+  TEST_ASSERT_TRUE(cal.calibration().dryRaw - cal.calibration().wetRaw >=
+                   fast.minSpan);
+}
+
+void test_soilsensor_autocalibration_persist_rules(void) {
+  FakeAdcBackend backend;
+  AdcScanner scanner(backend);
+  FakeConfigStorage storage;
+  SoilSensor sensor(2);
+  sensor.attachStorage(&storage, 0);
+  TEST_ASSERT_TRUE(sensor.begin(500, 200));
+  TEST_ASSERT_TRUE(sensor.attachScanner(&scanner));
+  TEST_ASSERT_TRUE(scanner.begin());
+  TEST_ASSERT_EQUAL(1, storage.writes);
+
+  AutoCalibrationConfig config;
+  config.confirmSamples = 1;
+  config.persistThreshold = 20;
+  config.persistIntervalMs = 500;
+  sensor.enableAutoCalibration(config);
+
+  // Drift within the interval, then a steady calibration: still written
+  // once the interval is over.
+  feedRun(sensor, scanner, backend, 560);
+  TEST_ASSERT_EQUAL(560, sensor.getCalibration().dryRaw);
+  TEST_ASSERT_EQUAL(1, storage.writes);
+  delay(501);
+  feedRun(sensor, scanner, backend, 400);
+  TEST_ASSERT_EQUAL(560, sensor.getCalibration().dryRaw);
+  TEST_ASSERT_EQUAL(2, storage.writes);
+
+  // A range that shrank below the starting one is used, not stored.
+  config.decayIntervalMs = 0;
+  config.decayShift = 1;
+  config.persistThreshold = 1;
+  config.persistIntervalMs = 0;
+  sensor.enableAutoCalibration(config);
+  for (int n = 0; n < 20; ++n) feedRun(sensor, scanner, backend, 380);
+  const ArduinoCommon::Sensors::SoilCalibration narrow =
+      sensor.getCalibration();
+  TEST_ASSERT_TRUE(narrow.dryRaw - narrow.wetRaw < 360);
+  TEST_ASSERT_TRUE(narrow.dryRaw - narrow.wetRaw >= config.minSpan);
+  TEST_ASSERT_EQUAL(2, storage.writes);
+
+  SoilSensor reader(1);
+  reader.attachStorage(&storage, 0);
+  TEST_ASSERT_TRUE(reader.begin());
+  TEST_ASSERT_EQUAL(560, reader.getCalibration().dryRaw);
+  TEST_ASSERT_EQUAL(200, reader.getCalibration().wetRaw);
+}
+
+void test_calibration_curve_lut(void) {
+  const CalibrationPoint points[] = {
+      {200, 100, 0}, {300, 80, 0}, {420, 30, 0}, {600, 0, 0}};
+  const CalibrationCurve curve = CalibrationCurve::piecewise(points, 4);
+  TEST_ASSERT_TRUE(curve.isValid());
+  TEST_ASSERT_EQUAL(600, curve.dryRaw);
+  TEST_ASSERT_EQUAL(200, curve.wetRaw);
+
+  CalibrationLut lut;
+  TEST_ASSERT_TRUE(lut.build(curve));
+  for (int raw = 0; raw <= 1023; ++raw) {
+    const int expected = static_cast<int>(curve.evaluate(raw) + 0.5f);
+    TEST_ASSERT_INT_WITHIN(1, expected, lut.toPercent(raw));
+  }
+  TEST_ASSERT_EQUAL(100, lut.toPercent(200));
+  TEST_ASSERT_EQUAL(0, lut.toPercent(600));
+
+  const CalibrationPoint unsorted[] = {{300, 80, 0}, {200, 100, 0}};
+  TEST_ASSERT_FALSE(CalibrationCurve::piecewise(unsorted, 2).isValid());
+
+  // percent = 150 - 0.25 * raw over [200,600].
+  const float coefficients[] = {150.0f, -0.25f};
+  const CalibrationCurve poly =
+      CalibrationCurve::polynomial(coefficients, 2, 600, 200);
+  TEST_ASSERT_TRUE(lut.build(poly));
+  TEST_ASSERT_EQUAL(100, lut.toPercent(100));
+  TEST_ASSERT_EQUAL(50, lut.toPercent(400));
+  TEST_ASSERT_EQUAL(0, lut.toPercent(900));
+}
+
+// Every raw value in (and around) a curve's range converts to within
+// rounding of the exact curve.
+static void assertLutMatchesCurve(const CalibrationCurve& curve, int last) {
+  CalibrationLut lut;
+  TEST_ASSERT_TRUE(lut.build(curve));
+  for (int raw = 0; raw <= last; ++raw) {
+    const int expected = static_cast<int>(curve.evaluate(raw) + 0.5f);
+    TEST_ASSERT_INT_WITHIN(1, expected, lut.toPercent(raw));
+  }
+}
+
+void test_calibration_lut_close_steep_breakpoints(void) {
+  const CalibrationPoint close[] = {{200, 100, 0}, {210, 50, 0}, {800, 0, 0}};
+  const CalibrationCurve closeCurve = CalibrationCurve::piecewise(close, 3);
+  assertLutMatchesCurve(closeCurve, 1023);
+  CalibrationLut lut;
+  TEST_ASSERT_TRUE(lut.build(closeCurve));
+  TEST_ASSERT_EQUAL(50, lut.toPercent(210));
+  TEST_ASSERT_EQUAL(75, lut.toPercent(205));
+
+  const CalibrationPoint steep[] = {
+      {0, 100, 0}, {3000, 60, 0}, {3100, 0, 0}, {4095, 0, 0}};
+  const CalibrationCurve steepCurve = CalibrationCurve::piecewise(steep, 4);
+  assertLutMatchesCurve(steepCurve, 4095);
+  TEST_ASSERT_TRUE(lut.build(steepCurve));
+  TEST_ASSERT_EQUAL(59, lut.toPercent(3001));
+  TEST_ASSERT_EQUAL(30, lut.toPercent(3050));
+
+  // Neighbouring breakpoints one count apart.
+  const CalibrationPoint adjacent[] = {
+      {100, 100, 0}, {101, 0, 0}, {102, 100, 0}, {30000, 0, 0}};
+  assertLutMatchesCurve(CalibrationCurve::piecewise(adjacent, 4), 1023);
+}
+
+void test_soilsensor_calibration_curve_versions(void) {
+  FakeConfigStorage storage;
+
+  // A version 1 (two-point) record still loads.
+  ArduinoCommon::Sensors::SoilCalibration legacy;
+  legacy.dryRaw = 500;
+  legacy.wetRaw = 200;
+  storage.write(0, &legacy, sizeof(legacy));
+
+  SoilSensor linear(11);
+  linear.attachStorage(&storage, 0, SoilSensor::CurveStorageSize);
+  TEST_ASSERT_TRUE(linear.begin());
+  TEST_ASSERT_FALSE(linear.hasCalibrationCurve());
+  TEST_ASSERT_EQUAL(50, linear.rawToPercent(350));
+
+  // A curve replaces it with a version 2 record...
+  const CalibrationPoint points[] = {{200, 100, 0}, {250, 90, 0}, {500, 0, 0}};
+  TEST_ASSERT_TRUE(linear.setCalibrationCurve(
+      CalibrationCurve::piecewise(points, 3)));
+  TEST_ASSERT_TRUE(linear.hasCalibrationCurve());
+  TEST_ASSERT_TRUE(linear.hasCalibration());
+  TEST_ASSERT_EQUAL(90, linear.rawToPercent(250));
+  TEST_ASSERT_FALSE(linear.setOversampling(1, true));
+
+  // Auto-calibration would replace the curve with two points.
+  TEST_ASSERT_FALSE(linear.enableAutoCalibration());
+  TEST_ASSERT_FALSE(linear.autoCalibrationEnabled());
+
+  // ...which a fresh sensor reads back.
+  SoilSensor curved(9);
+  curved.attachStorage(&storage, 0, SoilSensor::CurveStorageSize);
+  TEST_ASSERT_TRUE(curved.begin());
+  TEST_ASSERT_TRUE(curved.hasCalibrationCurve());
+  TEST_ASSERT_EQUAL(90, curved.rawToPercent(250));
+  TEST_ASSERT_EQUAL(45, curved.rawToPercent(375));
+  TEST_ASSERT_EQUAL(CalibrationCurve::Version, curved.getCalibration().version);
+
+  // A two-point calibration drops the curve again...
+  curved.setCalibration(500, 200, false);
+  TEST_ASSERT_FALSE(curved.hasCalibrationCurve());
+  TEST_ASSERT_EQUAL(50, curved.rawToPercent(350));
+
+  // ...and setting a curve turns auto-calibration off.
+  TEST_ASSERT_TRUE(curved.enableAutoCalibration());
+  TEST_ASSERT_TRUE(curved.setCalibrationCurve(
+      CalibrationCurve::piecewise(points, 3), false));
+  TEST_ASSERT_FALSE(curved.autoCalibrationEnabled());
+}
+
+void test_soilsensor_rejects_corrupt_record(void) {
+  FakeConfigStorage storage;
+  SoilSensor writer(5);
+  writer.attachStorage(&storage, 0);
+  TEST_ASSERT_TRUE(writer.begin(520, 210));
+
+  SoilSensor reader(4);
+  reader.attachStorage(&storage, 0);
+  TEST_ASSERT_TRUE(reader.begin());
+  TEST_ASSERT_EQUAL(520, reader.getCalibration().dryRaw);
+
+  // Flip one payload bit, as a torn or decayed write would.
+  storage.bytes[ArduinoCommon::Config::ConfigRecord::HeaderSize] ^= 0x04;
+  SoilSensor corrupted(3);
+  corrupted.attachStorage(&storage, 0);
+  TEST_ASSERT_TRUE(corrupted.begin());
+  TEST_ASSERT_FALSE(corrupted.hasCalibration());
+}
+
+void test_soilsensor_storage_slots(void) {
+  FakeConfigStorage storage;
+  const uint16_t slot = SoilSensor::CurveStorageSize;
+  TEST_ASSERT_EQUAL(16, SoilSensor::StorageSize);
+  TEST_ASSERT_TRUE(slot >= ArduinoCommon::Config::ConfigRecord::storedSize(
+                               sizeof(CalibrationCurve)));
+
+  SoilSensor first(8);
+  SoilSensor second(7);
+  TEST_ASSERT_TRUE(first.attachStorage(&storage, 0, slot));
+  TEST_ASSERT_TRUE(second.attachStorage(&storage, slot));
+
+  // A key past the 16-bit range fails loudly: begin() fails too...
+  SoilSensor third(6);
+  TEST_ASSERT_FALSE(third.attachStorage(&storage, 0xFFFF));
+  TEST_ASSERT_FALSE(third.begin());
+  TEST_ASSERT_FALSE(third.validConfiguration());
+  // ...until a valid slot is attached.
+  TEST_ASSERT_TRUE(third.attachStorage(nullptr, 0));
+  TEST_ASSERT_TRUE(third.begin());
+  TEST_ASSERT_TRUE(third.validConfiguration());
+
+  // A curve fills the slot without touching the neighbour...
+  TEST_ASSERT_TRUE(second.begin(520, 210));
+  TEST_ASSERT_TRUE(first.begin());
+  const CalibrationPoint points[] = {{200, 100, 0}, {250, 90, 0}, {500, 0, 0}};
+  TEST_ASSERT_TRUE(
+      first.setCalibrationCurve(CalibrationCurve::piecewise(points, 3)));
+  SoilSensor neighbour(10);
+  TEST_ASSERT_TRUE(neighbour.attachStorage(&storage, slot));
+  TEST_ASSERT_TRUE(neighbour.begin());
+  TEST_ASSERT_EQUAL(520, neighbour.getCalibration().dryRaw);
+
+  // ...and clearing removes all of it.
+  TEST_ASSERT_TRUE(first.clearCalibration());
+  TEST_ASSERT_FALSE(storage.isUsed(0, slot));
+  TEST_ASSERT_TRUE(storage.isUsed(slot, 1));
+
+  // A two-point slot never holds more than StorageSize bytes, even
+  // when a curve is set.
+  const uint16_t end = FakeConfigStorage::Size - SoilSensor::StorageSize;
+  SoilSensor small(4);
+  TEST_ASSERT_TRUE(small.attachStorage(&storage, end));
+  small.setCalibration(500, 200);
+  TEST_ASSERT_TRUE(
+      small.setCalibrationCurve(CalibrationCurve::piecewise(points, 3)));
+  TEST_ASSERT_TRUE(small.hasCalibrationCurve());
+  TEST_ASSERT_FALSE(storage.isUsed(end - 1, 1));
+  SoilCalibration stored;
+  TEST_ASSERT_EQUAL(ArduinoCommon::Config::RecordStatus::Ok,
+                    ArduinoCommon::Config::ConfigRecord::readValue(
+                        storage, end, SoilSensor::CalibrationRecordType,
+                        stored));
+  TEST_ASSERT_EQUAL(500, stored.dryRaw);
+
+  // Clearing it only touches the bytes the record occupies, so a
+  // backend that ends with the slot is not accessed out of range.
+  TEST_ASSERT_TRUE(small.clearCalibration());
+  TEST_ASSERT_FALSE(storage.isUsed(end, SoilSensor::StorageSize));
+}
+
+void test_soilsensor_keeps_legacy_layout(void) {
+  FakeConfigStorage storage;
+  const uint16_t legacySize = sizeof(SoilCalibration);
+
+  // Three sensors' unframed calibrations, packed back to back as older
+  // versions of the library wrote them.
+  for (uint16_t i = 0; i < 3; ++i) {
+    SoilCalibration legacy;
+    legacy.dryRaw = 500 + i;
+    legacy.wetRaw = 200;
+    storage.write(i * legacySize, &legacy, legacySize);
+  }
+
+  // Saving the first one again stays within its 6 bytes, and so does
+  // clearing it.
+  SoilSensor first(0);
+  TEST_ASSERT_TRUE(first.attachStorage(&storage, 0));
+  TEST_ASSERT_TRUE(first.begin());
+  TEST_ASSERT_EQUAL(500, first.getCalibration().dryRaw);
+  first.setCalibration(600, 250);
+
+  SoilCalibration stored;
+  TEST_ASSERT_TRUE(storage.read(0, &stored, legacySize));
+  TEST_ASSERT_EQUAL(600, stored.dryRaw);
+  TEST_ASSERT_TRUE(storage.read(legacySize, &stored, legacySize));
+  TEST_ASSERT_EQUAL(501, stored.dryRaw);
+
+  TEST_ASSERT_TRUE(first.clearCalibration());
+  TEST_ASSERT_FALSE(storage.isUsed(0, legacySize));
+  TEST_ASSERT_TRUE(storage.read(legacySize, &stored, legacySize));
+  TEST_ASSERT_EQUAL(501, stored.dryRaw);
+
+  // A slot declared at the legacy size starts out in that format.
+  SoilSensor third(5);
+  TEST_ASSERT_TRUE(
+      third.attachStorage(&storage, 2 * legacySize, legacySize));
+  third.setCalibration(700, 300);
+  TEST_ASSERT_TRUE(storage.read(2 * legacySize, &stored, legacySize));
+  TEST_ASSERT_EQUAL(700, stored.dryRaw);
+  TEST_ASSERT_FALSE(storage.isUsed(3 * legacySize, legacySize));
+  TEST_ASSERT_FALSE(third.attachStorage(&storage, 0, legacySize - 1));
+}
+
 void setup() {
   delay(2000);
   UNITY_BEGIN();
   RUN_TEST(test_soilsensor_begin_and_calibration);
+  RUN_TEST(test_soilsensor_async_sampling);
+  RUN_TEST(test_adcscanner_ring_buffer);
+  RUN_TEST(test_adcscanner_overrun_by_many_laps);
+  RUN_TEST(test_soilsensor_reads_from_scanner);
+  RUN_TEST(test_sensorgroup_batch_percent);
+  RUN_TEST(test_percentmap_matches_map_over_adc_range);
+  RUN_TEST(test_percentmap_every_range);
+  RUN_TEST(test_filter_stages);
+  RUN_TEST(test_filtered_sensor_pipeline);
+  RUN_TEST(test_soilsensor_oversampling);
+  RUN_TEST(test_static_soilsensor_matches_virtual);
+  RUN_TEST(test_sensor_history_window_stats);
+  RUN_TEST(test_soilsensor_watches);
+  RUN_TEST(test_autocalibrator_rejects_spikes);
+  RUN_TEST(test_soilsensor_autocalibration_throttles_writes);
+  RUN_TEST(test_autocalibrator_keeps_calibration_through_steady_readings);
+  RUN_TEST(test_soilsensor_autocalibration_persist_rules);
+  RUN_TEST(test_calibration_curve_lut);
+  RUN_TEST(test_calibration_lut_close_steep_breakpoints);
+  RUN_TEST(test_soilsensor_calibration_curve_versions);
+  RUN_TEST(test_soilsensor_rejects_corrupt_record);
+  RUN_TEST(test_soilsensor_storage_slots);
+  RUN_TEST(test_soilsensor_keeps_legacy_layout);
   UNITY_END();
 }
 
@@ -1,8 +1,10 @@
 #include <Arduino.h>
 #include <unity.h>
 
+#include <ArduinoCommon/Utils/I2cBusManager.h>
 #include <ArduinoCommon/Utils/PinManager.h>
 
+using ArduinoCommon::Utils::I2cBusManager;
 using ArduinoCommon::Utils::PinManager;
 
 void setUp(void) {
@@ -39,6 +41,48 @@ void test_double_reserve_same_pin_fails(void) {
   TEST_ASSERT_FALSE(PinManager::isPinUsed(pin));
 }
 
+void test_i2c_bus_pins_are_shared(void) {
+  const uint8_t sda = 4;
+  const uint8_t scl = 5;
+
+  TEST_ASSERT_TRUE(I2cBusManager::acquire(sda, scl));
+  TEST_ASSERT_TRUE(PinManager::isPinUsed(sda));
+  TEST_ASSERT_TRUE(I2cBusManager::acquire(sda, scl));
+  TEST_ASSERT_EQUAL_UINT8(2, I2cBusManager::userCount(sda, scl));
+
+  // The pins still belong to the bus, not to anyone else.
+  TEST_ASSERT_FALSE(PinManager::reservePin(sda));
+  TEST_ASSERT_FALSE(I2cBusManager::acquire(scl, sda));
+
+  I2cBusManager::release(sda, scl);
+  TEST_ASSERT_TRUE(PinManager::isPinUsed(scl));
+  I2cBusManager::release(sda, scl);
+  TEST_ASSERT_EQUAL_UINT8(0, I2cBusManager::userCount(sda, scl));
+  TEST_ASSERT_FALSE(PinManager::isPinUsed(sda));
+  TEST_ASSERT_FALSE(PinManager::isPinUsed(scl));
+}
+
+void test_i2c_controller_drives_one_pin_pair(void) {
+  int wire = 0;
+  int wire1 = 0;
+
+  TEST_ASSERT_TRUE(I2cBusManager::acquire(6, 7, &wire));
+  TEST_ASSERT_TRUE(I2cBusManager::acquire(6, 7, &wire));
+  TEST_ASSERT_FALSE(I2cBusManager::acquire(6, 7, &wire1));
+  TEST_ASSERT_FALSE(I2cBusManager::acquire(8, 9, &wire));
+  TEST_ASSERT_FALSE(PinManager::isPinUsed(8));
+
+  TEST_ASSERT_TRUE(I2cBusManager::acquire(8, 9, &wire1));
+  I2cBusManager::release(8, 9);
+
+  // Once released, the controller may move to another pair.
+  I2cBusManager::release(6, 7);
+  I2cBusManager::release(6, 7);
+  TEST_ASSERT_TRUE(I2cBusManager::acquire(8, 9, &wire));
+  I2cBusManager::release(8, 9);
+  TEST_ASSERT_FALSE(PinManager::isPinUsed(8));
+}
+
 // Arduino-style test runner
 
 void setup() {
@@ -49,6 +93,8 @@ void setup() {
 
   RUN_TEST(test_reserve_and_release_pin);
   RUN_TEST(test_double_reserve_same_pin_fails);
+  RUN_TEST(test_i2c_bus_pins_are_shared);
+  RUN_TEST(test_i2c_controller_drives_one_pin_pair);
 
   UNITY_END();
 }